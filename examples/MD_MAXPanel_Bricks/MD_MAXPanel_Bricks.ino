@@ -25,6 +25,7 @@
 #include "Font5x3.h"
 #include "score.h"
 #include "sound.h"
+#include "pool.h"
 
 // Turn on debug statements to the serial output
 #define  DEBUG  0
@@ -75,6 +76,7 @@ uint16_t FIELD_TOP, FIELD_RIGHT;   // needs to be initialised in setup()
 const uint16_t FIELD_LEFT = 1;
 
 const uint8_t BRICK_SIZE_DEFAULT = 3;
+const uint8_t MAX_BRICKS = 40;        // bricks that do not fit are left out
 const uint8_t BAT_SIZE_DEFAULT = 3;   // must be an odd number
 const uint8_t BAT_EDGE_OFFSET = 1;
 
@@ -281,58 +283,37 @@ private:
   struct brick_t
   {
     uint16_t x, y; // leftmost coordinate for this brick
-    brick_t *next; // the next in the linked list
   };
 
   uint8_t _size;      // size of the bricks
-  brick_t *_bricks;   // start of the list
-  brick_t *_deleted;  // the deleted list
+  cPool<brick_t, MAX_BRICKS> _bricks;  // the bricks in the field
 
   void draw(brick_t *pb)  { mp.drawHLine(pb->y, pb->x, pb->x + _size-1, true); }
   void erase(brick_t *pb) { mp.drawHLine(pb->y, pb->x, pb->x + _size-1, false); }
 
-  void add(uint16_t x, uint16_t y)
-  // add a brick to the start of the list
+  bool add(uint16_t x, uint16_t y)
+  // add a brick after the others, return false if there is no room
   {
-    brick_t *pb;
-    
-    if (_deleted == nullptr)
-      pb = new brick_t;
-    else
-    {
-      // take from the front of the deleted list
-      pb = _deleted;
-      _deleted = _deleted->next;
-    }
+    uint8_t h = _bricks.acquire();
 
-    pb->x = x;
-    pb->y = y;
-    pb->next = _bricks;
-    _bricks = pb;
+    if (h == _bricks.NONE)
+      return(false);
 
-    return(pb);
-  }
+    brick_t *pb = &_bricks.get(h);
 
-  void del(brick_t *pbPrev, brick_t *pb)
-  // delete the specified brick from the list
-  {
-    if (pbPrev == nullptr)
-      _bricks = pb->next;
-    else
-      pbPrev->next = pb->next;
+    pb->x = x;
+    pb->y = y;
 
-    // save to the front of the deleted list
-    pb->next = _deleted;
-    _deleted = pb;
+    return(true);
   }
 
   void dumpList(void)
   {
     PRINTS("\nDUMP List ===");
-    for (brick_t *pb = _bricks; pb != nullptr; pb = pb->next)
+    for (uint8_t i = 0; i < _bricks.count(); i++)
     {
-      PRINTXY("\n", pb->x, pb->y);
-      draw(pb);
+      PRINTXY("\n", _bricks[i].x, _bricks[i].y);
+      draw(&_bricks[i]);
     }
     PRINTS("\n===");
   }
@@ -361,7 +342,7 @@ public:
     PRINT(" Adj margin=", marginSide);
 
     _size = size;
-    _bricks = _deleted = nullptr;
+    _bricks.clear();
 
     // create all the bricks
     uint16_t x = xmin + marginSide;
@@ -372,7 +353,7 @@ public:
       PRINT("\nin column ", i);
       for (uint8_t j = 0; j < numDown; j++)
       {
-        add(x, y);
+        if (!add(x, y)) PRINTS(" no room");
         PRINTXY(" - ", x, y);
         y -= gapY;
       }
@@ -382,20 +363,20 @@ public:
     //dumpList();  // debug to verify the list is created properly
   }
 
-  bool emptyField(void) { return(_bricks == nullptr); }
-  void drawField(void)  { for (brick_t *pb = _bricks; pb != nullptr; pb = pb->next) draw(pb); }
-  void eraseField(void) { while (_bricks != nullptr) { erase(_bricks); del(nullptr, _bricks); } }
+  bool emptyField(void) { return(_bricks.empty()); }
+  void drawField(void)  { for (uint8_t i = 0; i < _bricks.count(); i++) draw(&_bricks[i]); }
+  void eraseField(void) { for (uint8_t i = 0; i < _bricks.count(); i++) erase(&_bricks[i]); _bricks.clear(); }
 
   bounce_t checkHits(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
   {
-    brick_t *pb = _bricks;
-    brick_t *pbPrev = nullptr;
     int16_t dx = x2 - x1;
     int16_t dy = y2 - y1;
     bounce_t b = BOUNCE_NONE;
 
-    while (pb != nullptr)
+    for (uint8_t i = _bricks.count(); i-- > 0; )
     {
+      brick_t *pb = &_bricks[i];
+
       if (y2 == pb->y)  // at the same height as this brick
       {
         // check one of the corners with sideways approach
@@ -428,13 +409,10 @@ public:
           PRINTXY("-", pb->x+_size-1, pb->y);
           PRINTS(" - deleting");
           erase(pb);
-          del(pbPrev, pb);
+          _bricks.releaseAt(i);
           break;   // no point looping further - only one brick per hit
         }
       }
-      // advance the pointers
-      pbPrev = pb;
-      pb = pb->next;
     }
 
     return(b);
@@ -30,13 +30,39 @@
 // preceding one. The rules continue to be applied repeatedly to create further 
 // generations.
 //
+// Other Life-like rules are described in B/S notation, giving the neighbour 
+// counts for a dead cell to be born and for a live cell to survive. Conway's 
+// rules above are B3/S23. Each new game uses the next rule from RULES[].
+//
+// Implementation
+// ==============
+// The universe is held by the cLife class (life.h) as rows of packed bits, 
+// and each generation is worked out for 32 cells at a time. Only the cells 
+// that change are sent to the display. The class also spots when the 
+// generations repeat, so a new game is started when the universe has been 
+// stuck in a still life or oscillator for a while. The edges of the universe 
+// wrap around, so the cells on each edge are neighbours of those on the 
+// opposite edge.
+//
+// With SPARSE_UNIVERSE set to 1 the universe is held by the cLifeTiles class 
+// (lifeTiles.h) instead. The universe has no edges and only the 8x8 tiles 
+// with live cells are kept, so gliders can fly on long after they leave the 
+// display, which shows a viewport onto the universe. A new game is started 
+// when the tiles run out. Each tile takes 22 bytes of RAM, so boards with 
+// more RAM than an Uno can use a larger LIFE_TILES.
+//
 
 #include <MD_MAXPanel.h>
 #include "randomseed.h"
+#include "life.h"
+#include "lifeTiles.h"
 
 // Turn on debug statements to the serial output
 #define  DEBUG  0
 
+// Set to 1 for a sparse universe that extends beyond the display
+#define SPARSE_UNIVERSE 0
+
 #if  DEBUG
 #define PRINT(s, x)   { Serial.print(F(s)); Serial.print(x); }
 #define PRINTS(x)     { Serial.print(F(x)); }
@@ -69,6 +95,38 @@ MD_MAXPanel mp = MD_MAXPanel(HARDWARE_TYPE, CS_PIN, X_DEVICES, Y_DEVICES);
 
 const uint8_t SWITCH_PIN = 6;
 
+// The universe is the same size as the panel
+const uint16_t LIFE_WIDTH = X_DEVICES * COL_SIZE;
+const uint16_t LIFE_HEIGHT = Y_DEVICES * ROW_SIZE;
+
+#if SPARSE_UNIVERSE
+const uint16_t LIFE_TILES = 32;   // tiles in the universe, a power of 2
+
+typedef cLifeTiles<LIFE_TILES> lifePanel_t;
+
+const uint16_t SEED_WIDTH = 16;   // random seed in the middle of the display
+const uint16_t SEED_HEIGHT = 16;
+#else
+typedef cLife<LIFE_WIDTH, LIFE_HEIGHT> lifePanel_t;
+
+const uint16_t SEED_WIDTH = LIFE_WIDTH;   // random seed fills the universe
+const uint16_t SEED_HEIGHT = LIFE_HEIGHT;
+#endif
+lifePanel_t life;
+
+// Rules used for each new game in turn
+const char *RULES[] =
+{
+  "B3/S23",       // Conway's Life
+  "B36/S23",      // HighLife
+  "B3678/S34678", // Day & Night
+  "B2/S",         // Seeds
+};
+
+const uint16_t MAX_GENERATIONS = 1000;   // start a new game after this many generations
+
+#define ARRAY_SIZE(a) (sizeof(a)/sizeof((a)[0]))
+
 // We always wait a bit between updates of the display
 const uint16_t TICK_TIME = 150;  // in milliseconds
 
@@ -83,135 +141,85 @@ void setup(void)
   
   if (!mp.begin()) PRINTS("\nMD_MAXPanel library failed to initialize.");
   mp.clear();
+#if SPARSE_UNIVERSE
+  life.setView(0, 0);
+#else
+  life.setEdge(lifePanel_t::TOROIDAL);
+#endif
   randomSeed(seedOut(31, RANDOM_SEED_PORT));
 }
 
 void loop(void)
 {
   static uint32_t timeLastRun = 0;
-  static uint8_t sameCount = 10;
-  static uint32_t lastCount = 0;
-  uint32_t count = countCells();
-  
-  if (lastCount == count) sameCount++; else sameCount = 0;
+  static uint8_t sameCount = 10;   // also set to 10 to start a new game
 
-  if (digitalRead(SWITCH_PIN) == LOW || sameCount >= 10)
+  if (digitalRead(SWITCH_PIN) == LOW || sameCount >= 10 || life.generation() >= MAX_GENERATIONS)
   {
     mp.clear();     // mark the end of the display ...
     delay(1000);    // ... with a minor pause!
     firstGeneration();
     sameCount = 0;
   }
-  lastCount = count;
     
   // Check if next generation time
   if (millis() - timeLastRun >= TICK_TIME)
   {
     timeLastRun = millis();
-    nextGeneration();
+    if (!nextGeneration()) sameCount = 10;
+    else if (life.period() != 0) sameCount++; 
+    else sameCount = 0;
   }
 }
 
-uint32_t countCells(void)
-{
-  uint32_t count = 0;
-
-  for (uint16_t x = 0; x <= mp.getXMax(); x++)
-    for (uint16_t y = 0; y <= mp.getYMax(); y++)
-      count += (mp.getPoint(x,y) ? 1:0);
-
-  return(count);
-}
-
 void firstGeneration(void)
-// Create a 4-way symmetric random setup
+// Create a 4-way symmetric random setup with the next rule
 {
-  mp.update(false);
+  static uint8_t rule = ARRAY_SIZE(RULES) - 1;
 
-  PRINTS("\n-- FIRST Generation");
-  PRINTXY("\n-- Field size (1,1) - ", mp.getXMax() - 1, mp.getYMax() - 1);
-  mp.clear();
-  for (uint16_t x=1; x<(mp.getXMax()+1) / 2; x++)
-    for (uint16_t y = 1; y < (mp.getYMax()+1) / 2; y++)
+  rule = (rule + 1) % ARRAY_SIZE(RULES);
+  life.setRule(RULES[rule]);
+
+  PRINT("\n-- FIRST Generation ", RULES[rule]);
+  PRINTXY("\n-- Field size (1,1) - ", SEED_WIDTH - 2, SEED_HEIGHT - 2);
+  life.clear();
+  for (uint16_t x = 1; x < SEED_WIDTH / 2; x++)
+    for (uint16_t y = 1; y < SEED_HEIGHT / 2; y++)
     {
+      const uint16_t x0 = (LIFE_WIDTH - SEED_WIDTH) / 2;
+      const uint16_t y0 = (LIFE_HEIGHT - SEED_HEIGHT) / 2;
       bool b = (random(101) > 50);
 
-      mp.setPoint(x, y, b);
-      mp.setPoint(mp.getXMax() - x, y, b);
-      mp.setPoint(x, mp.getYMax() - y, b);
-      mp.setPoint(mp.getXMax() - x, mp.getYMax() - y, b);
+      life.setCell(x0 + x, y0 + y, b);
+      life.setCell(x0 + SEED_WIDTH - 1 - x, y0 + y, b);
+      life.setCell(x0 + x, y0 + SEED_HEIGHT - 1 - y, b);
+      life.setCell(x0 + SEED_WIDTH - 1 - x, y0 + SEED_HEIGHT - 1 - y, b);
     }
-      
+
+  mp.update(false);
+  life.draw(mp);
   mp.update(true);
 }
 
-void nextGeneration(void)
-// Apply the rules
+bool nextGeneration(void)
+// Apply the rules and show the cells that changed. Return false if the 
+// universe ran out of room.
 {
-  bool rowBuf[2][mp.getXMax()+2];
-  uint16_t count;
-  bool newCell;
+  bool room = true;
 
   PRINTS("\n-- NEW generation");
-  // clear out the row buffers
-  memset(rowBuf, 0, sizeof(rowBuf));
-  mp.update(false);
-  
-  for (uint16_t y=mp.getYMax()-1; y>=1; y--)
-  {
-    // copy the current row to the buffer
-    for (uint16_t x=0; x<mp.getXMax(); x++)
-      rowBuf[1][x] = mp.getPoint(x, y);
-
-    // work out a 'new' current row
-    for (uint16_t x=1; x<mp.getXMax(); x++)
-    {
-      // count the number of neighbours
-      count = rowBuf[0][x-1] ? 1:0;
-      count += rowBuf[0][x]  ? 1:0;
-      count += rowBuf[0][x+1]? 1:0;
-      count += rowBuf[1][x-1]? 1:0;
-      count += rowBuf[1][x+1]? 1:0;
-      count += mp.getPoint(x-1, y-1)? 1:0;
-      count += mp.getPoint(x, y-1)  ? 1:0;
-      count += mp.getPoint(x+1, y-1)? 1:0;
-
-      PRINTXY("\n@", x, y);
-      PRINT(" count=", count);
-      PRINTS(" ->");
-      
-      if (count < 2)
-      {
-        // A live cell with fewer than two neighbors dies.
-        newCell = false;
-        PRINTS("dies.");
-      }
-      else if ((count == 2 || count == 3) && mp.getPoint(x, y))
-      {
-        // A live cell with two or three neighbors lives on.
-        newCell = true;
-        PRINTS("stays.");
-      }
-      else if (count == 3 && !mp.getPoint(x, y))
-      {
-        // A dead cell with exactly three neighbors becomes live.
-        newCell = true;
-        PRINTS("born.");
-      }
-      else
-      {
-        // A live cell with more than three neighbors dies.
-        newCell = false;
-        PRINTS("dies.");
-      }
-
-      mp.setPoint(x, y, newCell);
-    }
-
-    // update the saved row buffers
-    for (uint16_t x=0; x<=mp.getXMax(); x++)
-      rowBuf[0][x] = rowBuf[1][x];
-  }
+#if SPARSE_UNIVERSE
+  room = life.nextGeneration();
+  PRINT(" tiles=", life.tiles());
+#else
+  life.nextGeneration();
+#endif
+  PRINT(" population=", life.population());
+  PRINT(" period=", life.period());
 
+  mp.update(false);
+  life.draw(mp);
   mp.update(true);
+
+  return(room);
 }
@@ -0,0 +1,316 @@
+#pragma once
+
+// Number of live cells in a word
+inline uint8_t lifePopCount(uint16_t v) { return(__builtin_popcount(v)); }
+inline uint8_t lifePopCount(uint32_t v) { return(__builtin_popcountl(v)); }
+inline uint8_t lifePopCount(uint64_t v) { return(__builtin_popcountll(v)); }
+
+// A class to encapsulate a Life-like rule.
+//
+// The rule is set in B/S notation, such as "B3/S23" for Conway's Life or 
+// "B36/S23" for HighLife, and is turned into a mask word for each neighbour 
+// count. next() works out the next generation of a word of cells from the 
+// words of their neighbours, adding the neighbour bits in parallel with full 
+// adder logic. The new cells are picked from the masks by the bits of the 
+// count, so all rules take the same time.
+template <typename T>
+class cLifeRule
+{
+public:
+  cLifeRule(void) { set("B3/S23"); }
+
+  bool set(const char *rule)
+  // Set the rule from B/S notation, the neighbour counts for a birth and 
+  // those for a cell to survive. Return false if the rule is not valid.
+  {
+    uint16_t set[2] = { 0, 0 };   // bit n set for n neighbours
+    int8_t cur = -1;
+
+    for ( ; *rule != '\0'; rule++)
+    {
+      if (*rule == 'B' || *rule == 'b') cur = 0;
+      else if (*rule == 'S' || *rule == 's') cur = 1;
+      else if (*rule >= '0' && *rule <= '8' && cur != -1) set[cur] |= (1 << (*rule - '0'));
+      else if (*rule != '/') return(false);
+    }
+
+    for (uint8_t n = 0; n <= 8; n++)
+    {
+      _mask[0][n] = (set[0] & (1 << n)) ? ~(T)0 : 0;
+      _mask[1][n] = (set[1] & (1 << n)) ? ~(T)0 : 0;
+    }
+
+    return(true);
+  }
+
+  T next(T aw, T a, T ae, T bw, T b, T be, T cw, T c, T ce)
+  // Work out the next generation of the cells in b from the rows above (a)
+  // and below (c), with the neighbours to the west (w) and east (e) of each 
+  // cell shifted into line. The neighbour count for each cell is kept as 
+  // bits s0 to s3 in parallel words.
+  {
+    // add the three 2 bit counts of the rows
+    T a0 = aw ^ a ^ ae, a1 = (aw & a) | (ae & (aw ^ a));
+    T c0 = cw ^ c ^ ce, c1 = (cw & c) | (ce & (cw ^ c));
+    T b0 = bw ^ be, b1 = bw & be;
+    T s0 = a0 ^ b0 ^ c0;
+    T k = (a0 & b0) | (c0 & (a0 ^ b0));   // carry into the 2s
+    T u = a1 ^ b1, v = c1 ^ k;
+    T s1 = u ^ v;
+    T p = a1 & b1, q = c1 & k, r = u & v;   // carries into the 4s
+    T s2 = p ^ q ^ r;
+    T s3 = (p & q) | (r & (p ^ q));
+
+    // pick the births for dead cells and the survivors for live cells
+    T born = select(_mask[0], s0, s1, s2, s3);
+    T stay = select(_mask[1], s0, s1, s2, s3);
+
+    return(mux(b, born, stay));
+  }
+
+private:
+  T _mask[2][9];    // births and survivals, all ones for each neighbour count in the rule
+
+  static T mux(T s, T a, T b) { return(a ^ ((a ^ b) & s)); }   // bits of b where s is set, else a
+
+  static T select(const T *m, T s0, T s1, T s2, T s3)
+  // select the rule mask for the neighbour count of each cell
+  {
+    T c01 = mux(s0, m[0], m[1]), c23 = mux(s0, m[2], m[3]);
+    T c45 = mux(s0, m[4], m[5]), c67 = mux(s0, m[6], m[7]);
+    T c0_7 = mux(s2, mux(s1, c01, c23), mux(s1, c45, c67));
+
+    return(mux(s3, c0_7, m[8]));
+  }
+};
+
+// A class to detect repeating generations.
+//
+// A hash of each generation is kept in a ring of the last SIZE hashes. A 
+// generation with the same hash as one in the ring has repeated, so the 
+// universe is stuck in a still life or an oscillator with that period.
+class cLifeHistory
+{
+public:
+  static const uint8_t SIZE = 16;       // longest period detected
+  static const uint32_t HASH_BASIS = 2166136261UL;   // FNV-1a hash constants
+  static const uint32_t HASH_PRIME = 16777619UL;
+
+  static uint32_t hash(uint32_t h, uint16_t v) { return((h ^ v) * HASH_PRIME); }
+  static uint32_t hash(uint32_t h, uint32_t v) { return((h ^ v) * HASH_PRIME); }
+  static uint32_t hash(uint32_t h, uint64_t v) { return(hash(hash(h, (uint32_t)v), (uint32_t)(v >> 32))); }
+
+  void clear(void) { _count = 0; _period = 0; }   // forget the history
+  uint8_t period(void) { return(_period); }       // period of the last generation added, 0 if none
+
+  uint8_t add(uint32_t h)
+  // look for the hash of a generation in the history, then add it
+  {
+    _period = 0;
+    for (uint8_t k = 1; k <= _count && _period == 0; k++)
+      if (_hash[(_next + SIZE - k) % SIZE] == h)
+        _period = k;
+
+    _hash[_next] = h;
+    _next = (_next + 1) % SIZE;
+    if (_count < SIZE) _count++;
+
+    return(_period);
+  }
+
+private:
+  uint32_t _hash[SIZE];   // ring of the hashes of recent generations
+  uint8_t _next = 0;      // next entry in _hash
+  uint8_t _count = 0;     // number of valid entries in _hash
+  uint8_t _period = 0;    // period found for the last generation added
+};
+
+// A class to encapsulate a Game of Life universe.
+//
+// The universe is W cells wide and H cells high, held as rows of packed bits
+// in words of type T (uint32_t or uint64_t), with cell x of a row in bit
+// (x % BITS) of word (x / BITS). The next generation is worked out for a whole
+// word of cells at a time by cLifeRule, so the cost does not depend on how 
+// many cells are alive. The edges of the universe are either bounded, with 
+// the cells outside always dead, or toroidal, where the cells on each edge 
+// are neighbours of those on the opposite edge.
+//
+// Two copies of the universe are kept so that draw() can send only the cells
+// that changed in the last generation to the display. If more has changed
+// since the last draw(), all the cells of the changed rows are sent.
+//
+// The number of live cells is counted as each generation is worked out, and
+// repeating generations are found by cLifeHistory.
+template <uint16_t W, uint16_t H, typename T = uint32_t>
+class cLife
+{
+public:
+  static const uint8_t BITS = 8 * sizeof(T);              // cells in each word
+  static const uint16_t WORDS = (W + BITS - 1) / BITS;    // words in each row
+
+  enum edge_t { BOUNDED, TOROIDAL };
+
+  bool setRule(const char *rule)
+  // set the rule from B/S notation, return false if the rule is not valid
+  {
+    if (!_rule.set(rule)) return(false);
+    _history.clear();   // the generations no longer follow the history
+    return(true);
+  }
+
+  void setEdge(edge_t e) { _edge = e; _history.clear(); }
+
+  void clear(void)
+  // kill all the cells
+  {
+    memset(_cell, 0, sizeof(_cell));
+    memset(_changed, 0xff, sizeof(_changed));
+    _drawRows = true;
+    _population = 0;
+    _generation = 0;
+    _history.clear();
+  }
+
+  bool getCell(uint16_t x, uint16_t y)
+  {
+    if (x >= W || y >= H) return(false);
+    return((_cell[_cur][y][x / BITS] >> (x % BITS)) & 1);
+  }
+
+  void setCell(uint16_t x, uint16_t y, bool b)
+  {
+    if (x >= W || y >= H) return;
+
+    T *p = &_cell[_cur][y][x / BITS];
+    T bit = (T)1 << (x % BITS);
+
+    if (((*p & bit) != 0) != b)
+    {
+      if (b) { *p |= bit; _population++; }
+      else   { *p &= ~bit; _population--; }
+      _changed[y / 8] |= (1 << (y % 8));
+      _drawRows = true;
+      _history.clear();   // the history no longer leads here
+    }
+  }
+
+  uint32_t population(void) { return(_population); }   // number of live cells
+  uint32_t generation(void) { return(_generation); }    // generations since clear()
+  uint8_t period(void) { return(_history.period()); }   // period of the repeating generations, 0 if none
+
+  void nextGeneration(void)
+  // work out the next generation from the current one
+  {
+    static const T zero[WORDS] = { 0 };
+    const T *edgeRow[2] = { zero, zero };   // rows beyond the bottom and top edges
+    T (*src)[WORDS] = _cell[_cur];
+    T (*dst)[WORDS] = _cell[_cur ^ 1];
+    uint32_t hash = cLifeHistory::HASH_BASIS;
+
+    if (_edge == TOROIDAL)
+    {
+      edgeRow[0] = src[H - 1];
+      edgeRow[1] = src[0];
+    }
+
+    _population = 0;
+    for (uint16_t y = 0; y < H; y++)
+    {
+      const T *above = (y < H - 1) ? src[y + 1] : edgeRow[1];
+      const T *below = (y > 0) ? src[y - 1] : edgeRow[0];
+
+      nextRow(dst[y], above, src[y], below);
+
+      bool changed = false;
+      for (uint16_t i = 0; i < WORDS; i++)
+      {
+        _population += lifePopCount(dst[y][i]);
+        hash = cLifeHistory::hash(hash, dst[y][i]);
+        changed = changed || (dst[y][i] != src[y][i]);
+      }
+
+      if (changed)
+        _changed[y / 8] |= (1 << (y % 8));
+    }
+
+    _history.add(hash);
+    _drawRows = _drawRows || _drawDiff;   // the last generation was not drawn
+    _drawDiff = true;
+    _cur ^= 1;
+    _generation++;
+  }
+
+  template <class P> void draw(P &mp, bool all = false)
+  // Show the universe on the display with cell (0, 0) at display (0, 0).
+  // Only the cells that changed since the last draw() are sent to the display,
+  // unless all is true.
+  {
+    for (uint16_t y = 0; y < H; y++)
+    {
+      if (!all && (_changed[y / 8] & (1 << (y % 8))) == 0)
+        continue;
+
+      for (uint16_t i = 0; i < WORDS; i++)
+      {
+        T cell = _cell[_cur][y][i];
+        T diff = (all || _drawRows) ? ~(T)0 : cell ^ _cell[_cur ^ 1][y][i];
+
+        for (uint16_t x = i * BITS; diff != 0 && x < W; x++, cell >>= 1, diff >>= 1)
+          if (diff & 1) mp.setPoint(x, y, cell & 1);
+      }
+    }
+    memset(_changed, 0, sizeof(_changed));
+    _drawRows = _drawDiff = false;
+  }
+
+  void nextRow(T *out, const T *above, const T *row, const T *below)
+  // work out the next generation of a row from the rows above and below
+  {
+    for (uint16_t i = 0; i < WORDS; i++)
+      out[i] = _rule.next(west(above, i), above[i], east(above, i),
+                          west(row, i), row[i], east(row, i),
+                          west(below, i), below[i], east(below, i));
+    out[WORDS - 1] &= LAST_MASK;
+  }
+
+private:
+  static const T LAST_MASK = (W % BITS == 0) ? ~(T)0 : (((T)1 << (W % BITS)) - 1);  // cells used in the last word
+  static const uint8_t LAST_BIT = (W - 1) % BITS;   // bit of the last cell in the last word
+
+  T _cell[2][H][WORDS];       // current and last universe
+  uint8_t _cur = 0;           // index of the current universe
+  uint8_t _changed[(H + 7) / 8];  // a bit for each row changed since the last draw()
+  bool _drawDiff = false;     // the last generation is not yet drawn
+  bool _drawRows = false;     // draw all the cells of the changed rows
+  uint32_t _population = 0;   // number of live cells
+  uint32_t _generation = 0;   // number of generations since clear()
+  cLifeHistory _history;      // hashes of recent generations
+  cLifeRule<T> _rule;         // rule for the next generation
+  edge_t _edge = BOUNDED;     // edge mode
+
+  T west(const T *r, uint16_t i)
+  // cells shifted one place east, so each bit holds its west neighbour
+  {
+    T carry = 0;
+
+    if (i > 0)
+      carry = r[i - 1] >> (BITS - 1);
+    else if (_edge == TOROIDAL)
+      carry = (r[WORDS - 1] >> LAST_BIT) & 1;
+
+    return((r[i] << 1) | carry);
+  }
+
+  T east(const T *r, uint16_t i)
+  // cells shifted one place west, so each bit holds its east neighbour
+  {
+    T carry = 0;
+
+    if (i < WORDS - 1)
+      carry = r[i + 1] << (BITS - 1);
+    else if (_edge == TOROIDAL)
+      carry = (r[0] & 1) << LAST_BIT;
+
+    return((r[i] >> 1) | carry);
+  }
+};
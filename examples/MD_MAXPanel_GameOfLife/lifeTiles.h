@@ -0,0 +1,329 @@
+#pragma once
+
+#include "life.h"
+
+// A class to encapsulate a sparse Game of Life universe.
+//
+// The universe covers all the int16_t cell coordinates, but only the parts
+// with live cells are held in memory, as tiles of 8x8 cells. The tiles are
+// kept in a hash table of TILES entries (a power of 2) and found by linear
+// probing from a hash of the tile coordinates. Before each generation the
+// empty neighbours of tiles with live cells on their edges are added, so
+// there is room for the births, and tiles that have been empty for two
+// generations are dropped. If the table is full the births that need a new
+// tile are lost and nextGeneration() returns false.
+//
+// Each tile row is a byte with cell x in bit x and row 0 at the bottom. The
+// next generation of a tile row is worked out by cLifeRule in a 16 bit word
+// holding the row and the edge cells of the tiles to the west and east.
+//
+// The display shows a viewport onto the universe, with the cell set by
+// setView() at display (0, 0). Both generations are kept in each tile so
+// that draw() only sends the cells that changed to the display.
+template <uint16_t TILES>
+class cLifeTiles
+{
+public:
+  static const uint8_t TILE = 8;    // cells on each side of a tile
+
+  cLifeTiles(void) { clear(); }
+
+  bool setRule(const char *rule)
+  // set the rule from B/S notation, return false if the rule is not valid
+  {
+    if (!_rule.set(rule)) return(false);
+    _history.clear();   // the generations no longer follow the history
+    return(true);
+  }
+
+  void setView(int16_t x, int16_t y) { _viewX = x; _viewY = y; _drawAll = true; }
+
+  void clear(void)
+  // kill all the cells
+  {
+    for (uint16_t i = 0; i < TILES; i++)
+      _tile[i].used = false;
+    _tiles = 0;
+    _population = 0;
+    _generation = 0;
+    _history.clear();
+    _drawAll = true;
+  }
+
+  bool getCell(int16_t x, int16_t y)
+  {
+    tile_t *t = find(x >> 3, y >> 3);
+
+    return(t != nullptr && (t->row[_cur][y & 7] >> (x & 7)) & 1);
+  }
+
+  bool setCell(int16_t x, int16_t y, bool b)
+  // set a cell, return false if there is no room for a new tile
+  {
+    tile_t *t = b ? add(x >> 3, y >> 3) : find(x >> 3, y >> 3);
+
+    if (t == nullptr) return(!b);
+
+    uint8_t *p = &t->row[_cur][y & 7];
+    uint8_t bit = 1 << (x & 7);
+
+    if (((*p & bit) != 0) != b)
+    {
+      if (b) { *p |= bit; _population++; }
+      else   { *p &= ~bit; _population--; }
+      _history.clear();   // the history no longer leads here
+      _drawAll = true;
+    }
+
+    return(true);
+  }
+
+  uint32_t population(void) { return(_population); }   // number of live cells
+  uint32_t generation(void) { return(_generation); }    // generations since clear()
+  uint8_t period(void) { return(_history.period()); }   // period of the repeating generations, 0 if none
+  uint16_t tiles(void) { return(_tiles); }              // number of tiles in use
+
+  bool nextGeneration(void)
+  // Work out the next generation from the current one. Return false if
+  // births were lost for lack of tiles.
+  {
+    bool room = true;
+    uint32_t hash = 0;
+
+    // add the tiles the live cells can spread into
+    for (uint16_t i = 0; i < TILES; i++)
+    {
+      if (!_tile[i].used) continue;
+
+      const uint8_t *r = _tile[i].row[_cur];
+      int16_t x = _tile[i].x, y = _tile[i].y;
+      uint8_t cols = 0;
+
+      for (uint8_t j = 0; j < TILE; j++)
+        cols |= r[j];
+      if (cols == 0) continue;
+
+      if (cols & 0x01) room &= (add(x - 1, y) != nullptr);
+      if (cols & 0x80) room &= (add(x + 1, y) != nullptr);
+      if (r[0] != 0) room &= (add(x, y - 1) != nullptr);
+      if (r[TILE - 1] != 0) room &= (add(x, y + 1) != nullptr);
+      if (r[0] & 0x01) room &= (add(x - 1, y - 1) != nullptr);
+      if (r[0] & 0x80) room &= (add(x + 1, y - 1) != nullptr);
+      if (r[TILE - 1] & 0x01) room &= (add(x - 1, y + 1) != nullptr);
+      if (r[TILE - 1] & 0x80) room &= (add(x + 1, y + 1) != nullptr);
+    }
+
+    // work out the next generation of each tile
+    for (uint16_t i = 0; i < TILES; i++)
+      if (_tile[i].used)
+        nextTile(&_tile[i]);
+    _cur ^= 1;
+
+    // drop the tiles that have been empty for both generations
+    for (uint16_t i = 0; i < TILES; )
+    {
+      uint8_t live = 0;
+
+      if (_tile[i].used)
+        for (uint8_t j = 0; j < TILE; j++)
+          live |= _tile[i].row[0][j] | _tile[i].row[1][j];
+
+      if (_tile[i].used && live == 0)
+        drop(i);    // a later tile may have moved into this entry
+      else
+        i++;
+    }
+
+    // count the cells and hash the generation
+    _population = 0;
+    for (uint16_t i = 0; i < TILES; i++)
+    {
+      tile_t *t = &_tile[i];
+      uint32_t h = cLifeHistory::HASH_BASIS;
+      uint8_t live = 0;
+
+      if (!t->used) continue;
+
+      h = cLifeHistory::hash(h, (uint16_t)t->x);
+      h = cLifeHistory::hash(h, (uint16_t)t->y);
+      for (uint8_t j = 0; j < TILE; j++)
+      {
+        live |= t->row[_cur][j];
+        _population += lifePopCount((uint16_t)t->row[_cur][j]);
+        h = cLifeHistory::hash(h, (uint16_t)t->row[_cur][j]);
+      }
+      if (live != 0)
+        hash += h;    // the order of the tiles in the table does not matter
+    }
+
+    _history.add(hash);
+    _drawAll = _drawAll || _drawDiff;   // the last generation was not drawn
+    _drawDiff = true;
+    _generation++;
+
+    return(room);
+  }
+
+  template <class P> void draw(P &mp, bool all = false)
+  // Show the viewport on the display. Only the cells that changed since the
+  // last draw() are sent to the display, unless all is true.
+  {
+    all = all || _drawAll;
+    if (all) mp.clear();
+
+    for (uint16_t i = 0; i < TILES; i++)
+    {
+      tile_t *t = &_tile[i];
+
+      if (!t->used) continue;
+
+      int16_t x0 = (t->x * TILE) - _viewX;
+      int16_t y0 = (t->y * TILE) - _viewY;
+
+      if (x0 <= -TILE || x0 > (int16_t)mp.getXMax() || y0 <= -TILE || y0 > (int16_t)mp.getYMax())
+        continue;   // not in the viewport
+
+      for (uint8_t j = 0; j < TILE; j++)
+      {
+        uint8_t cell = t->row[_cur][j];
+        uint8_t diff = all ? cell : cell ^ t->row[_cur ^ 1][j];
+        int16_t y = y0 + j;
+
+        if (y < 0 || y > (int16_t)mp.getYMax()) continue;
+
+        for (int16_t x = x0; diff != 0; x++, cell >>= 1, diff >>= 1)
+          if ((diff & 1) && x >= 0 && x <= (int16_t)mp.getXMax())
+            mp.setPoint(x, y, cell & 1);
+      }
+    }
+    _drawAll = _drawDiff = false;
+  }
+
+private:
+  static const uint16_t INDEX_MASK = TILES - 1;
+
+  struct tile_t
+  {
+    int16_t x, y;             // tile coordinates, the tile holds cells from (x * TILE, y * TILE)
+    uint8_t row[2][TILE];     // current and last generation rows
+    bool used;                // true if the entry holds a tile
+  };
+
+  tile_t _tile[TILES];        // hash table of tiles
+  uint16_t _tiles = 0;        // number of tiles in use
+  uint8_t _cur = 0;           // index of the current generation in each tile
+  uint32_t _population = 0;   // number of live cells
+  uint32_t _generation = 0;   // number of generations since clear()
+  int16_t _viewX = 0, _viewY = 0;   // cell shown at display (0, 0)
+  bool _drawDiff = false;     // the last generation is not yet drawn
+  bool _drawAll = true;       // draw all the viewport
+  cLifeHistory _history;      // hashes of recent generations
+  cLifeRule<uint16_t> _rule;  // rule for the next generation
+
+  static uint16_t slot(int16_t x, int16_t y)
+  // first table entry to look at for a tile
+  {
+    uint16_t h = ((uint16_t)x * 0x9e37) ^ ((uint16_t)y * 0x79b9);
+
+    return((h ^ (h >> 8)) & INDEX_MASK);
+  }
+
+  tile_t *find(int16_t x, int16_t y)
+  // return the tile, or nullptr if it is not in the table
+  {
+    uint16_t i = slot(x, y);
+
+    for (uint16_t n = 0; n < TILES && _tile[i].used; n++, i = (i + 1) & INDEX_MASK)
+      if (_tile[i].x == x && _tile[i].y == y)
+        return(&_tile[i]);
+
+    return(nullptr);
+  }
+
+  tile_t *add(int16_t x, int16_t y)
+  // return the tile, adding an empty one if needed, or nullptr if the table is full
+  {
+    uint16_t i = slot(x, y);
+
+    for (uint16_t n = 0; n < TILES; n++, i = (i + 1) & INDEX_MASK)
+    {
+      if (!_tile[i].used)
+      {
+        _tile[i].x = x;
+        _tile[i].y = y;
+        memset(_tile[i].row, 0, sizeof(_tile[i].row));
+        _tile[i].used = true;
+        _tiles++;
+        return(&_tile[i]);
+      }
+      if (_tile[i].x == x && _tile[i].y == y)
+        return(&_tile[i]);
+    }
+
+    return(nullptr);
+  }
+
+  void drop(uint16_t i)
+  // Remove the tile in entry i. The tiles after it in the same run of used
+  // entries are moved back if they can be, so every tile can still be found
+  // from its first entry without a gap in between.
+  {
+    _tile[i].used = false;
+    _tiles--;
+
+    for (uint16_t j = (i + 1) & INDEX_MASK; _tile[j].used; j = (j + 1) & INDEX_MASK)
+    {
+      uint16_t k = slot(_tile[j].x, _tile[j].y);
+
+      // move the tile unless its first entry is after the gap, up to j
+      if (((j - k) & INDEX_MASK) >= ((j - i) & INDEX_MASK))
+      {
+        _tile[i] = _tile[j];
+        _tile[j].used = false;
+        i = j;
+      }
+    }
+  }
+
+  uint16_t edgeRow(tile_t *nb[3][3], int8_t j)
+  // Row j of the middle tile of nb, the tile and its neighbours, as a 10 bit 
+  // word with the cells in bits 1 to 8 and the edge cells of the tiles to 
+  // the west and east in bits 0 and 9. Row -1 and row TILE are the edge rows 
+  // of the tiles below and above.
+  {
+    tile_t **t = nb[1];
+    uint16_t v = 0;
+
+    if (j < 0) { t = nb[0]; j = TILE - 1; }
+    else if (j >= TILE) { t = nb[2]; j = 0; }
+
+    if (t[0] != nullptr) v |= t[0]->row[_cur][j] >> 7;
+    if (t[1] != nullptr) v |= (uint16_t)t[1]->row[_cur][j] << 1;
+    if (t[2] != nullptr) v |= (uint16_t)(t[2]->row[_cur][j] & 1) << 9;
+
+    return(v);
+  }
+
+  void nextTile(tile_t *t)
+  // work out the next generation of a tile into the other rows
+  {
+    tile_t *nb[3][3];   // the tile and its neighbours, [y][x] from the bottom left
+
+    for (int8_t dy = -1; dy <= 1; dy++)
+      for (int8_t dx = -1; dx <= 1; dx++)
+        nb[dy + 1][dx + 1] = (dx == 0 && dy == 0) ? t : find(t->x + dx, t->y + dy);
+
+    uint16_t below = edgeRow(nb, -1);
+    uint16_t row = edgeRow(nb, 0);
+
+    for (int8_t j = 0; j < TILE; j++)
+    {
+      uint16_t above = edgeRow(nb, j + 1);
+      uint16_t next = _rule.next(above << 1, above, above >> 1, row << 1, row, row >> 1, below << 1, below, below >> 1);
+
+      t->row[_cur ^ 1][j] = next >> 1;
+      below = row;
+      row = above;
+    }
+  }
+};
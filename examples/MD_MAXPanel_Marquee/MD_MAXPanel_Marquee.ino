@@ -0,0 +1,76 @@
+// Scrolling text marquee using the MD_MAXPanel_Scroller class
+//
+// Two messages scroll at different speeds in separate bands of the
+// display. The top message pauses at the tab characters in the text.
+//
+// Libraries used
+// ==============
+// MD_MAX72XX available from https://github.com/MajicDesigns/MD_MAX72XX
+//
+
+#include <MD_MAXPanel.h>
+
+// Turn on debug statements to the serial output
+#define  DEBUG  0
+
+#if  DEBUG
+#define PRINT(s, x)   { Serial.print(F(s)); Serial.print(x); }
+#define PRINTS(x)     { Serial.print(F(x)); }
+
+#else
+#define PRINT(s, x)
+#define PRINTS(x)
+
+#endif
+
+// Define the number of devices we have in the chain and the hardware interface
+// NOTE: These pin numbers will probably not work with your hardware and may
+// need to be adapted
+const MD_MAX72XX::moduleType_t HARDWARE_TYPE = MD_MAX72XX::FC16_HW;
+const uint8_t X_DEVICES = 4;
+const uint8_t Y_DEVICES = 5;
+
+const uint8_t CLK_PIN = 13;   // or SCK
+const uint8_t DATA_PIN = 11;  // or MOSI
+const uint8_t CS_PIN = 10;    // or SS
+
+// SPI hardware interface
+MD_MAXPanel mp = MD_MAXPanel(HARDWARE_TYPE, CS_PIN, X_DEVICES, Y_DEVICES);
+// Arbitrary pins
+// MD_MAXPanel mx = MD_MAXPanel(HARWARE_TYPE, DATA_PIN, CLK_PIN, CS_PIN, X_DEVICES, Y_DEVICES);
+
+// One scroller for each band of the display
+MD_MAXPanel_Scroller top(&mp);
+MD_MAXPanel_Scroller bottom(&mp);
+
+const char msgTop[] = "Hello\tfrom\tMD_MAXPanel\t";
+const char msgBottom[] = "Scrolling one column at a time with MD_MAXPanel_Scroller ";
+
+void setup(void)
+{
+#if  DEBUG
+  Serial.begin(57600);
+#endif
+  PRINTS("\n[MD_MAXPanel Marquee]");
+
+  if (!mp.begin()) PRINTS("\nMD_MAXPanel library failed to initialize.");
+  mp.clear();
+
+  const uint16_t h = mp.getFontHeight();
+
+  top.begin(0, mp.getYMax() - h + 1, mp.getXMax(), mp.getYMax());
+  top.setSpeed(40);
+  top.setPause(1000);
+  top.setMessage(msgTop);
+
+  bottom.begin(0, 0, mp.getXMax(), h - 1);
+  bottom.setSpeed(25);
+  bottom.setInvert(true);
+  bottom.setMessage(msgBottom);
+}
+
+void loop(void)
+{
+  if (top.tick()) PRINTS("\nTop message done");
+  if (bottom.tick()) PRINTS("\nBottom message done");
+}
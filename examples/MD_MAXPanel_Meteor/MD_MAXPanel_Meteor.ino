@@ -29,6 +29,8 @@
 #include "score.h"
 #include "sound.h"
 #include "randomseed.h"
+#include "pool.h"
+#include "cellGrid.h"
 
 // Turn on debug statements to the serial output
 #define  DEBUG  0
@@ -98,6 +100,8 @@ const uint8_t ROID_MID_SIZE = 2;
 const uint8_t ROID_SML_SIZE = 1;
 
 const uint8_t MAX_BULLETS = 5;
+const uint8_t MAX_METEORS = 32;
+const uint8_t GRID_CELLS = X_DEVICES * Y_DEVICES;   // one cell for each display module
 
 // A class to encapsulate the shooter
 // Shooter is at the bottom of the display shooting bullets upwards
@@ -183,11 +187,10 @@ public:
 class cBullet
 {
 private:
-typedef struct bullet_t
+  struct bullet_t
   {
     uint16_t x, y;         // the position of the center of the bullet
     uint32_t timeLastMove; // time bullet last moved
-    bullet_t *next;        // next in the list
   };
   
   uint8_t _pinShoot;       // the shooting switch pin
@@ -195,57 +198,26 @@ typedef struct bullet_t
   uint32_t _moveDelay;     // delay between bullets moves in milliseconds
   uint16_t _shootDelay;    // the delay between shots in milliseconds
   uint32_t _timeLastShoot; // the last time the gun was shot in milliseconds
-  bullet_t *_bullets;      // the queue of bullets being fired
-  bullet_t *_deleted;      // delete bullets list
-  bullet_t *_pScan;        // for getFirst(), getNext()
-  uint8_t _count;          // count the number of bullets
+  cPool<bullet_t, MAX_BULLETS> _bullets;  // the bullets being fired
+  uint8_t _scan;           // for getFirst(), getNext()
 
-  bullet_t *add(uint16_t x, uint16_t y)
+  bool add(uint16_t x, uint16_t y)
   {
-    bullet_t* pb = nullptr;
+    uint8_t h = _bullets.acquire();
 
-    if (_count < MAX_BULLETS)
-    {
-      if (_deleted == nullptr)
-      {
-        pb = new bullet_t;
-        PRINTS(" new");
-      }
-      else
-      {
-        // take one from the front of the deleted queue
-        pb = _deleted;
-        _deleted = _deleted->next;
-        PRINTS(" recyle");
-      }
+    if (h == _bullets.NONE)
+      return(false);
 
-      // save the data
-      if (pb != nullptr)
-      {
-        _count++;
-        pb->x = x;
-        pb->y = y;
-        pb->timeLastMove = 0;
-        pb->next = _bullets;
-        _bullets = pb;
-      }
-    }
-    return(pb);
-  }
+    // save the data
+    bullet_t *pb = &_bullets.get(h);
 
-  void del(bullet_t *pbPrev, bullet_t * pb)
-  {
-    if (pbPrev == nullptr)
-      _bullets = pb->next;
-    else
-      pbPrev->next = pb->next;
-    _count--;
-
-    // save to the front of the deleted list
-    pb->next = _deleted;
-    _deleted = pb;
+    pb->x = x;
+    pb->y = y;
+    pb->timeLastMove = 0;
+
+    return(true);
   }
-  
+
 public:
   void begin(uint16_t ymin, uint16_t ymax, uint8_t pinShoot)
   {
@@ -253,72 +225,58 @@ public:
     _shootDelay = _moveDelay * 3;
     _ymin = ymin;
     _ymax = ymax;
-    _deleted = _bullets = nullptr;
+    _bullets.clear();
     _pinShoot = pinShoot;
-    _count = 0;
 
     pinMode(_pinShoot, INPUT_PULLUP);
   }
 
   bool getFirstXY(uint16_t &x, uint16_t &y) 
   { 
-    _pScan = _bullets;
-    if (_pScan == nullptr)
-      return(false);
-
-    x = _pScan->x;
-    y = _pScan->y;
-    _pScan = _pScan->next;
-
-    return(true); 
+    _scan = _bullets.count();
+    return(getNextXY(x, y));
   }
 
   bool getNextXY(uint16_t &x, uint16_t &y)
+  // scan from the last bullet to the first, so kill() does not upset the scan
   {
-    if (_pScan == nullptr)
+    if (_scan == 0)
       return(false);
 
-    x = _pScan->x;
-    y = _pScan->y;
-    _pScan = _pScan->next;
+    _scan--;
+    x = _bullets[_scan].x;
+    y = _bullets[_scan].y;
 
     return(true);
   }
 
-  void draw(bullet_t *pb)  { if (pb != nullptr) mp.setPoint(pb->x, pb->y, true); } //PRINTXY("\nbullet @", pb->x, pb->y); }
-  void erase(bullet_t *pb) { if (pb != nullptr) mp.setPoint(pb->x, pb->y, false); }
+  void draw(bullet_t *pb)  { mp.setPoint(pb->x, pb->y, true); } //PRINTXY("\nbullet @", pb->x, pb->y); }
+  void erase(bullet_t *pb) { mp.setPoint(pb->x, pb->y, false); }
 
-  void reset(void) { while (_bullets != nullptr) { erase(_bullets); del(nullptr, _bullets); }}
-  bool empty(void) { return (_bullets == nullptr); }
+  void reset(void) { for (uint8_t i = 0; i < _bullets.count(); i++) erase(&_bullets[i]); _bullets.clear(); }
+  bool empty(void) { return (_bullets.empty()); }
 
   void kill(uint16_t x, uint16_t y)
   // search for and kill the bullet at (x, y)
   {
-    bullet_t *pb = _bullets;
-    bullet_t *pbPrev = nullptr;
-
-    while (pb!= nullptr)
+    for (uint8_t i = _bullets.count(); i-- > 0; )
     { 
-      if (pb->x == x && pb->y == y)
+      if (_bullets[i].x == x && _bullets[i].y == y)
       {
-        erase(pb);
-        del(pbPrev, pb);
+        erase(&_bullets[i]);
+        _bullets.releaseAt(i);
         break;    // found it, no need to look further
       }
-      // advance pointers
-      pbPrev = pb;
-      pb = pb->next;
     }
   }
   
   void move(void) 
   { 
-    bullet_t *pb = _bullets;
-    bullet_t *pbPrev = nullptr;
-    
     mp.update(false);
-    while (pb != nullptr)
+    for (uint8_t i = _bullets.count(); i-- > 0; )
     {
+      bullet_t *pb = &_bullets[i];
+
       // is this the time for a move? 
       if (millis() - pb->timeLastMove >= _moveDelay)
       {
@@ -331,15 +289,11 @@ public:
         if (pb->y >= FIELD_TOP)
         {
           PRINTS("\n-- BULLET ending");
-          del(pbPrev, pb);
-          pb = pbPrev;    // we have just deleted pb!
+          _bullets.releaseAt(i);
         }
         else
           draw(pb);
       }
-      // advance pointers
-      pbPrev = pb;
-      if (pb != nullptr) pb = pb->next;
     }
     mp.update(true);
   }
@@ -358,7 +312,7 @@ public:
     if (digitalRead(_pinShoot) == LOW)
     {
       PRINTS("\n-- BULLET shoot");
-      b = (add(x, y) != nullptr);
+      b = add(x, y);
     }
       
     return(b);
@@ -366,25 +320,26 @@ public:
 };
 
 // A class to encapsulate all the meteors
+// The meteors are also kept in a grid of display cells, so the meteors that
+// could be hit by a bullet are found without looking at all of them.
 class cMeteors
 {
 private:
-  typedef struct meteor_t
+  struct meteor_t
   {
     // NOTE - these are uint8_t to save RAM
     uint8_t x, y;         // lower tip coordinate for this meteor
     uint8_t dx, dy;       // speed in the x, y direction
     uint8_t size;         // size of the meteor (BIG, MID, SML)
     uint32_t timeLastMove;// when this meteor last moved
-    meteor_t *next;       // the next in the linked list
   };
 
   uint32_t _timeTick;      // base time multiplied by size
   uint32_t _timeLastBorn;  // last time an meteor was born
   uint32_t _timeGestation; // time between meteors being born
-  meteor_t *_meteors;      // start of the list
-  meteor_t *_deleted;      // the deleted list
-  meteor_t *_pScan;        // for getFirst(), getNext()
+  cPool<meteor_t, MAX_METEORS> _meteors;  // the meteors in the field
+  cCellGrid<MAX_METEORS, GRID_CELLS> _grid; // the meteors in each display cell
+  uint8_t _scan;           // for getFirst(), getNext()
 
   void drawBig(meteor_t *pa, bool b)
   {
@@ -437,50 +392,88 @@ private:
   }
 
   meteor_t *add(uint16_t x, uint16_t y)
-  // add a brick to the start of the list
+  // add a meteor after the others, return nullptr if there is no room
   {
-    meteor_t *pa = nullptr;
+    uint8_t h = _meteors.acquire();
 
-    if (_deleted == nullptr)
+    if (h == _meteors.NONE)
     {
-      pa = new meteor_t;
-      PRINTS("new");
+      PRINTS(" full");
+      return(nullptr);
     }
-    else
+
+    meteor_t *pa = &_meteors.get(h);
+
+    pa->x = x;
+    pa->y = y;
+    pa->dx = 0;
+    pa->dy = -1;
+    pa->size = ROID_BIG_SIZE;
+    pa->timeLastMove = 0;
+    _grid.add(h, x, y);
+
+    return(pa);
+  }
+
+  void del(uint8_t h)
+  // delete the meteor with handle h
+  {
+    _grid.remove(h);
+    _meteors.release(h);
+  }
+
+  void split(meteor_t *pa, uint8_t size)
+  // split the meteor into two of the smaller size moving apart
+  {
+    meteor_t *paNew = add(pa->x, pa->y);
+
+    pa->dx = -1;
+    pa->size = size;
+    draw(pa);
+    if (paNew != nullptr)   // room for the other half
     {
-      // take from the front of the deleted list
-      pa = _deleted;
-      _deleted = _deleted->next;
-      PRINTS("recyle");
+      paNew->dx = 1;
+      paNew->size = size;
+      draw(paNew);
     }
+  }
 
-    if (pa != nullptr)
+  bool isHit(meteor_t *pa, uint16_t x, uint16_t y)
+  // is the meteor hit by a bullet at x, y?
+  {
+    switch (pa->size)
     {
-      pa->x = x;
-      pa->y = y;
-      pa->dx = 0;
-      pa->dy = -1;
-      pa->size = ROID_BIG_SIZE;
-      pa->timeLastMove = 0;
-
-      pa->next = _meteors;
-      _meteors = pa;
+    case ROID_SML_SIZE:   // front on point hit only
+    case ROID_MID_SIZE:
+      return(pa->x == x && pa->y == y);
+
+    case ROID_BIG_SIZE:   // front on point and either side hits
+      return((pa->x == x && pa->y == y) ||
+        ((pa->x - 1 == x || pa->x + 1 == x) && (pa->y + 1 == y)));
+
+    default:
+      PRINT("\n--- CHECKHIT UNKNOWN size=", pa->size);
+      break;
     }
 
-    return(pa);
+    return(false);
   }
 
-  void del(meteor_t *paPrev, meteor_t *pa)
-  // delete the specified brick from the list
+  uint8_t find(uint16_t x, uint16_t y)
+  // return the handle of a meteor hit by a bullet at x, y, or NONE
   {
-    if (paPrev == nullptr)
-      _meteors = pa->next;
-    else
-      paPrev->next = pa->next;
-
-    // save to the front of the deleted list
-    pa->next = _deleted;
-    _deleted = pa;
+    // a meteor tip is no more than 1 pixel to the side of or below the bullet,
+    // so only the cells around those pixels need to be looked at
+    uint8_t c0 = _grid.col(x > 0 ? x - 1 : 0), c1 = _grid.col(x + 1);
+    uint8_t r0 = _grid.row(y > 0 ? y - 1 : 0), r1 = _grid.row(y);
+
+    for (uint8_t r = r0; r <= r1; r++)
+      for (uint8_t c = c0; c <= c1; c++)
+        for (uint8_t h = _grid.first(c, r); h != _grid.NONE; h = _grid.next(h))
+          if (isHit(&_meteors.get(h), x, y))
+            return(h);
+
+    return(_grid.NONE);
   }
 
   bool generate(void)
@@ -504,51 +497,45 @@ private:
 public:
   void begin()
   {
-    _meteors = _deleted = nullptr;
+    _meteors.clear();
+    if (!_grid.begin(FIELD_RIGHT + 1, FIELD_TOP)) PRINTS("\nGrid is too small for the field.");
     _timeTick = 250;
     _timeGestation = 5000;
   }
 
-  bool emptyField(void) { return(_meteors == nullptr); }
-  void drawField(void)  { for (meteor_t *pa = _meteors; pa != nullptr; pa = pa->next) draw(pa); }
-  void eraseField(void) { while (_meteors != nullptr) { erase(_meteors); del(nullptr, _meteors); } }
+  bool emptyField(void) { return(_meteors.empty()); }
+  void drawField(void)  { for (uint8_t i = 0; i < _meteors.count(); i++) draw(&_meteors[i]); }
+  void eraseField(void) { for (uint8_t i = 0; i < _meteors.count(); i++) erase(&_meteors[i]); _meteors.clear(); _grid.clear(); }
 
   bool getFirstXY(uint16_t &x, uint16_t &y)
   {
-    _pScan = _meteors;
-    if (_pScan == nullptr)
-      return(false);
-
-    x = _pScan->x;
-    y = _pScan->y;
-    _pScan = _pScan->next;
-
-    return(true);
+    _scan = _meteors.count();
+    return(getNextXY(x, y));
   }
 
   bool getNextXY(uint16_t &x, uint16_t &y)
   {
-    if (_pScan == nullptr)
+    if (_scan == 0)
       return(false);
 
-    x = _pScan->x;
-    y = _pScan->y;
-    _pScan = _pScan->next;
+    _scan--;
+    x = _meteors[_scan].x;
+    y = _meteors[_scan].y;
 
     return(true);
   }
 
   void move(void)
   {
-    meteor_t *pa = _meteors;
-    meteor_t *paPrev = nullptr;
-    
     mp.update(false);
 
     generate();   // create a new one if time to do so
 
-    while (pa != nullptr)
+    // count down, as a deleted meteor is replaced by the last one
+    for (uint8_t i = _meteors.count(); i-- > 0; )
     {
+      meteor_t *pa = &_meteors[i];
+
       // is this the time for a move? 
       if (millis() - pa->timeLastMove >= _timeTick * pa->size)
       {
@@ -562,8 +549,7 @@ public:
         if (pa->y == 0)     
         {
           PRINTS("\n-- ASTEROID ending bottom");
-          del(paPrev, pa);
-          pa = paPrev;    // we have just deleted pa!
+          del(_meteors.handle(i));
         }
         else
         {
@@ -573,16 +559,15 @@ public:
           if (pa->x <= FIELD_LEFT || pa->x >= FIELD_RIGHT)
           {
             PRINTS("\n-- ASTEROID ending side");
-            del(paPrev, pa);
-            pa = paPrev;    // we have just deleted pa!
+            del(_meteors.handle(i));
           }
           else
+          {
+            _grid.move(_meteors.handle(i), pa->x, pa->y);
             draw(pa);
+          }
         }
       }
-      // advance pointers
-      paPrev = pa;
-      if (pa != nullptr) pa = pa->next;
     }
 
     mp.update(true);
@@ -591,73 +576,34 @@ public:
   uint8_t checkHits(uint16_t x, uint16_t y)
   // Returns the points for the meteor hit
   {
-    meteor_t *pa = _meteors;
-    meteor_t *paPrev = nullptr;
-    meteor_t *paNew;
+    uint8_t h = find(x, y);
     uint8_t points = 0;
-    bool notFound = true;
 
     //PRINTXY("\n--- CHECKHITS for ", x, y);
-    
-    while (pa != nullptr && notFound)
-    {
-      switch (pa->size)
-      {
-      case ROID_SML_SIZE:   // front on point hit only
-        if (pa->x == x && pa->y == y)
-        {
-          //PRINTXY("\n-- ASTEROID SML hit @", pa->x, pa->y);
-          // smallest one just gets deleted
-          erase(pa);
-          del(paPrev, pa);
-          points = 4;
-          notFound = false;
-        }
-        break;
-
-      case ROID_MID_SIZE:   // front on point hit only
-        if (pa->x == x && pa->y == y)
-        {
-          //PRINTXY("\n-- ASTEROID MID hit @", pa->x, pa->y);
-          // needs to be split
-          erase(pa);
-          paNew = add(pa->x, pa->y);
-          pa->dx = -1;
-          paNew->dx = 1;
-          pa->size = paNew->size = ROID_SML_SIZE;
-          draw(pa);
-          draw(paNew);
-          points = 2;
-          notFound = false;
-        }
-        break;
 
-      case ROID_BIG_SIZE:    // front on point and either side hits
-        if ((pa->x == x && pa->y == y) ||
-          ((pa->x - 1 == x || pa->x + 1 == x) && (pa->y + 1 == y)))
-        {
-          //PRINTXY("\n-- ASTEROID BIG hit @", pa->x, pa->y);
-          // needs to be split
-          erase(pa);
-          paNew = add(pa->x, pa->y);
-          pa->dx = -1;
-          paNew->dx = 1;
-          pa->size = paNew->size = ROID_MID_SIZE;
-          draw(pa);
-          draw(paNew);
-          points = 1;
-          notFound = false;
-        }
-        break;
+    if (h == _grid.NONE)
+      return(points);
 
-      default:
-        PRINT("\n--- CHECKHIT UNKNOWN size=", pa->size);
-        break;
-      }
+    meteor_t *pa = &_meteors.get(h);
 
-      // advance the pointers
-      paPrev = pa;
-      if (pa != nullptr) pa = pa->next;
+    //PRINTXY("\n-- ASTEROID hit @", pa->x, pa->y);
+    erase(pa);
+    switch (pa->size)
+    {
+    case ROID_SML_SIZE:   // smallest one just gets deleted
+      del(h);
+      points = 4;
+      break;
+
+    case ROID_MID_SIZE:   // needs to be split
+      split(pa, ROID_SML_SIZE);
+      points = 2;
+      break;
+
+    case ROID_BIG_SIZE:   // needs to be split
+      split(pa, ROID_MID_SIZE);
+      points = 1;
+      break;
     }
 
     return(points);
@@ -0,0 +1,96 @@
+#pragma once
+
+// A class to find the objects near a point on the display.
+//
+// The display is split into square cells CELL_SIZE pixels on each side,
+// one cell for each display module, and each cell has a list of the
+// objects in it. The objects are known by their handles, numbers less than
+// N, and each object is in the cell of its reference point. An object is
+// only moved to another list when it moves into another cell, so keeping
+// the lists up to date costs little as the objects move. To find the
+// objects near a point, only the lists of the cells around the point need
+// to be looked at, however many objects there are in the rest of the
+// display.
+//
+// The lists are linked both ways through arrays indexed by the handle, so
+// an object is added or removed in the same short time wherever it is in
+// its list.
+template <uint8_t N, uint8_t CELLS>
+class cCellGrid
+{
+public:
+  static const uint8_t CELL_SIZE = 8;   // pixels on each side of a cell
+  static const uint8_t NONE = 0xff;     // end of a list
+
+  static_assert(N < NONE, "Too many objects for the handles");
+
+  bool begin(uint16_t width, uint16_t height)
+  // set the size of the grid in pixels, return false if it is too big
+  {
+    _cols = (width + CELL_SIZE - 1) / CELL_SIZE;
+    _rows = (height + CELL_SIZE - 1) / CELL_SIZE;
+    clear();
+
+    return((uint16_t)_cols * _rows <= CELLS);
+  }
+
+  void clear(void)
+  // empty all the cells
+  {
+    memset(_head, NONE, sizeof(_head));
+  }
+
+  uint8_t col(uint16_t x) { x /= CELL_SIZE; return(x < _cols ? x : _cols - 1); }
+  uint8_t row(uint16_t y) { y /= CELL_SIZE; return(y < _rows ? y : _rows - 1); }
+
+  uint8_t first(uint8_t c, uint8_t r) { return(_head[(r * _cols) + c]); }  // first object in the cell
+  uint8_t next(uint8_t h) { return(_next[h]); }                            // next object in the same cell
+
+  void add(uint8_t h, uint16_t x, uint16_t y)
+  // add object h with its reference point at x, y
+  {
+    link(h, (row(y) * _cols) + col(x));
+  }
+
+  void remove(uint8_t h)
+  // remove object h from its cell
+  {
+    if (_prev[h] == NONE)
+      _head[_cell[h]] = _next[h];
+    else
+      _next[_prev[h]] = _next[h];
+
+    if (_next[h] != NONE)
+      _prev[_next[h]] = _prev[h];
+  }
+
+  void move(uint8_t h, uint16_t x, uint16_t y)
+  // object h has moved its reference point to x, y
+  {
+    uint8_t c = (row(y) * _cols) + col(x);
+
+    if (c != _cell[h])
+    {
+      remove(h);
+      link(h, c);
+    }
+  }
+
+private:
+  uint8_t _cols, _rows;   // size of the grid in cells
+  uint8_t _head[CELLS];   // first object in each cell
+  uint8_t _next[N];       // next object in the same cell
+  uint8_t _prev[N];       // previous object in the same cell
+  uint8_t _cell[N];       // cell the object is in
+
+  void link(uint8_t h, uint8_t c)
+  // put object h at the front of the list for cell c
+  {
+    _cell[h] = c;
+    _prev[h] = NONE;
+    _next[h] = _head[c];
+    if (_head[c] != NONE)
+      _prev[_head[c]] = h;
+    _head[c] = h;
+  }
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+// A class to hold up to N objects of type T without using the heap.
+//
+// The live objects are kept packed at the start of an array, so they are
+// found by counting through the array rather than following pointers. An
+// object is added at the end of the live objects and, when one is removed,
+// the last live object is moved into its place, so both take the same short
+// time however many objects there are. As the objects move, each one also
+// has a handle, a small number that stays the same while it is live, and
+// the handles of the removed objects are kept for reuse after the live ones.
+//
+// When objects are removed while counting through them, count down from the
+// last one, so the object moved into the place of a removed one has already
+// been seen.
+template <typename T, uint8_t N>
+class cPool
+{
+public:
+  typedef uint8_t handle_t;
+  static const handle_t NONE = 0xff;    // returned when the pool is full
+
+  static_assert(N < NONE, "Pool is too big for the handles");
+
+  cPool(void) { clear(); }
+
+  void clear(void)
+  // remove all the objects
+  {
+    _count = 0;
+    for (uint8_t i = 0; i < N; i++)
+      _handle[i] = _index[i] = i;
+  }
+
+  uint8_t count(void) { return(_count); }   // number of live objects
+  bool empty(void) { return(_count == 0); }
+  bool full(void) { return(_count == N); }
+
+  T &operator[](uint8_t i) { return(_obj[i]); }       // live object i, counting from 0
+  handle_t handle(uint8_t i) { return(_handle[i]); }  // handle of live object i
+  T &get(handle_t h) { return(_obj[_index[h]]); }     // live object with handle h
+
+  handle_t acquire(void)
+  // add an object after the live objects and return its handle, or NONE
+  // if the pool is full. The object is not initialised.
+  {
+    if (_count == N)
+      return(NONE);
+
+    return(_handle[_count++]);
+  }
+
+  void release(handle_t h) { releaseAt(_index[h]); }
+
+  void releaseAt(uint8_t i)
+  // remove live object i, moving the last live object into its place
+  {
+    uint8_t last = --_count;
+    handle_t h = _handle[i];
+
+    if (i != last)
+    {
+      _obj[i] = _obj[last];
+      _handle[i] = _handle[last];
+      _index[_handle[i]] = i;
+
+      // keep the freed handle after the live ones
+      _handle[last] = h;
+      _index[h] = last;
+    }
+  }
+
+private:
+  T _obj[N];              // the objects, live ones first
+  handle_t _handle[N];    // handle of the object in each place
+  uint8_t _index[N];      // place of the object for each handle
+  uint8_t _count;         // number of live objects
+};
@@ -70,8 +70,10 @@ public:
  /**
   * Update the display.
   *
-  * Update the display if there have been any changes. The bForce parameter can be used
-  * to force the update even if no changes.
+  * Update the display if there have been any changes. Only the characters of each field 
+  * that are different from the last update are redrawn. The bForce parameter can be used
+  * to force the update of all the fields even if no changes, for example after the 
+  * display has been cleared.
   * 
   * This method should be invoked very frequently as field/clock updates do not automatically 
   * update the display. Ideally this method if called every time through loop().
@@ -88,15 +90,13 @@ public:
 
       while (f != nullptr)
       {
-        char sz[f->size+10];
-
+        if (bForce) f->last[0] = '\0';
         switch (f->type)
         {
-        case MMMSS: formatTime(sz, f->value, 3, f->leadZero);   break;
-        case MMSS:  formatTime(sz, f->value, 2, f->leadZero);   break;
-        default:    formatNum(sz, f->value, f->size, f->leadZero); break;
+        case MMMSS: _mp->drawTimeChanges(f->x, f->y, f->value % (1000 * 60), f->last, 3, f->leadZero); break;
+        case MMSS:  _mp->drawTimeChanges(f->x, f->y, f->value % (100 * 60), f->last, 2, f->leadZero);  break;
+        default:    _mp->drawNumberChanges(f->x, f->y, f->value, f->last, f->size, (f->leadZero ? '0' : ' ')); break;
         }
-        _mp->drawText(f->x, f->y, sz);
 
         f = f->next;
       }
@@ -155,7 +155,8 @@ public:
         f->y = y;
         f->value = 0;
         f->leadZero = leadZero;
-        f->size = size;
+        f->size = (size > MAX_FIELD_SIZE ? MAX_FIELD_SIZE : size);
+        f->last[0] = '\0';
         _changed = true;
       }
     }
@@ -191,7 +192,7 @@ public:
   /**
    * Set the field display length.
    *
-   * Set the length of the field in characters when displayed.
+   * Set the length of the field in characters when displayed, up to MAX_FIELD_SIZE.
    *
    * \sa fieldCreate(), fieldSetLeadZero()
    *
@@ -205,7 +206,7 @@ public:
 
     if (f != nullptr)
     {
-      f->size = size;
+      f->size = (size > MAX_FIELD_SIZE ? MAX_FIELD_SIZE : size);
       _changed = true;
     }
 
@@ -470,6 +471,7 @@ public:
 private:
   static const uint8_t  MAX_CLOCKS = 3;       ///< maximum number of closks for this class
   static const uint32_t CLOCK_PERIOD = 1000;  ///< 1 second in milliseconds
+  static const uint8_t  MAX_FIELD_SIZE = 10;  ///< maximum field size in characters
 
   // Define data to keep track of fields
   struct field_t
@@ -480,6 +482,7 @@ private:
     uint32_t value;   ///< current value of the field
     bool leadZero;    ///< field has leading zeroes
     uint8_t size;     ///< field size in characters/numbers
+    char last[MAX_FIELD_SIZE + 1];  ///< field text last displayed
     field_t* next;    ///< next in the list
   };
 
@@ -564,28 +567,4 @@ private:
       }
     }
   }
-
-  void formatNum(char* sz, uint32_t n, uint8_t size, bool leadZero)
-  { 
-    int8_t idx = size - 1;
-
-    // initialise the buffer
-    memset(sz, (leadZero ? '0' : ' '), size);
-    sz[size] = '\0';
-
-    do
-    {
-      sz[idx--] = (n % 10) + '0';
-      n /= 10;
-    }
-    while (n != 0 && idx >= 0);
-  }
-
-  void formatTime(char* sz, uint32_t n, uint8_t m, bool leadZero)
-  {
-    formatNum(sz, n / 60, m, leadZero);
-    sz[m] = ':';
-    formatNum(&sz[m+1], n % 60, 2, true);
-    sz[m+3] = '\0';
-  }
 };
\ No newline at end of file
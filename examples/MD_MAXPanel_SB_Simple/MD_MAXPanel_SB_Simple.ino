@@ -78,6 +78,9 @@ const uint32_t MAX_SCORE = 999;
 
 cScoreboard sb(&mp);
 
+// Glyph cache for the digits, space and colon, so the fields redraw quickly
+MD_MAXPanel::glyphCache_t glyphCache[12];
+
 void processUI(void)
 // Process the switches and act according to their function
 {
@@ -145,6 +148,7 @@ void setup(void)
   if (mp.begin())
   {
     mp.setFont(_Fixed_7x5);
+    mp.setGlyphCache(glyphCache, ARRAY_SIZE(glyphCache));
     mp.setRotation(MD_MAXPanel::ROT_90);
     mp.setIntensity(4);
     mp.clear();
@@ -20,12 +20,30 @@
 // Guide the snake around the screen using the direction keys. Running into
 // a pill will increase the length of the snake. Running into the sides or 
 // the snake will end the game.
+//
+// Implementation
+// ==============
+// The snake body is kept as a ring buffer of packed cell coordinates, and the
+// cells used by the snake and the walls are marked in a bitmap (snakeGrid.h),
+// so collisions do not depend on what is shown on the display. The pill is 
+// placed by picking one of the free cells at random, so placing it takes the 
+// same time however long the snake is.
+//
+// Demo Mode
+// =========
+// If no game is started for DEMO_DELAY the snake is steered by the autopilot
+// in snakeAI.h until a switch is pressed, so the game will run unattended 
+// for as long as needed. The autopilot heads for the pill along the shortest
+// path, unless that could trap the snake, when it follows a path that visits
+// every cell of the field in turn.
 
 #include <MD_MAXPanel.h>
 #include "Font5x3.h"
 #include "score.h"
 #include "sound.h"
 #include "randomseed.h"
+#include "snakeGrid.h"
+#include "snakeAI.h"
 
 // Turn on debug statements to the serial output
 #define  DEBUG  1
@@ -72,11 +90,16 @@ MD_MAXPanel mp = MD_MAXPanel(HARDWARE_TYPE, CS_PIN, X_DEVICES, Y_DEVICES);
 // Arbitrary pins
 // MD_MAXPanel mx = MD_MAXPanel(HARDWARE_TYPE, DATA_PIN, CLK_PIN, CS_PIN, X_DEVICES, Y_DEVICES);
 
+// Cells in use by the snake and walls, one bit for each cell in the display
+const uint16_t GRID_CELLS = (X_DEVICES * COL_SIZE) * (Y_DEVICES * ROW_SIZE);
+cSnakeGrid<GRID_CELLS> grid;
+
 uint16_t FIELD_TOP, FIELD_RIGHT;    // needs to be initialised in setup()
 const uint16_t FIELD_LEFT = 0;
 const uint16_t FIELD_BOTTOM = 0;
 
 const uint8_t SNAKE_SIZE_DEFAULT = 2;
+const uint16_t SNAKE_SIZE_MAX = 256;   // longest snake, each segment needs 2 bytes of RAM
 
 const char TITLE_TEXT[] = "SNAKE";
 const uint16_t SPLASH_DELAY =3000;     // in milliseconds
@@ -85,11 +108,15 @@ const char GAME_TEXT[] = "GAME";
 const char OVER_TEXT[] = "OVER";
 const uint16_t GAME_OVER_DELAY = 3000;   // in milliseconds
 
+const uint16_t DEMO_DELAY = 10000;     // idle time before the demo starts, in milliseconds
+const uint16_t SEARCH_QUEUE = 64;      // cells in the autopilot search queue, each needs 2 bytes of RAM
+
 const uint8_t MAX_LENGTH = 999;
 
 const uint8_t FONT_NUM_WIDTH = 3;
 const uint16_t MAX_SCORE = MAX_LENGTH;
 const uint16_t MAX_FOOD = 99;
+const uint8_t PILL_VALUE_MAX = 9;
 
 // A class to encapsulate the snake direction switches
 // Can move up, down, left, right
@@ -138,20 +165,12 @@ class cPill
 {
 private:
   uint16_t _x, _y;        // pill coordinates
-  uint16_t _xmin, _xmax;  // boundaries for the creation of the pill
-  uint16_t _ymin, _ymax;
   uint8_t  _value;        // value of the pill
 
 public:
-  void begin(uint16_t xmin, uint16_t ymin, uint16_t xmax, uint16_t ymax)
+  void begin(void)
   {
     _value = 0;
-    _xmin = xmin;
-    _xmax = xmax;
-    _ymin = ymin;
-    _ymax = ymax;
-    PRINTXY("\n-- PILL boundaries ", _xmin, _ymin);
-    PRINTXY(" to ", _xmax, _ymax);
   }
 
   uint16_t getX(void) { return(_x); }
@@ -160,14 +179,15 @@ public:
 
   void reset(void)
   {
-    do  // search for an unused space
-    {
-      _x = _xmin + (random(_xmax - _xmin + 1));
-      _y = _ymin + (random(_ymax - _ymin + 1));
-      //PRINTXY("\n--- PILL TEST ", _x, _y);
-    } while (mp.getPoint(_x, _y));
+    if (grid.freeCells() == 0)
+      return;   // nowhere to put it
 
-    _value = random(10);
+    // pick one of the unused cells
+    uint16_t c = grid.select(random(grid.freeCells()));
+
+    _x = grid.cellX(c);
+    _y = grid.cellY(c);
+    _value = random(PILL_VALUE_MAX + 1);
     PRINTXY("\n-- PILL @", _x, _y);
     PRINT(" worth ", _value);
 
@@ -179,16 +199,9 @@ public:
 class cSnake
 {
 private:
-  struct snakeNode_t
-  {
-    uint8_t x, y;       // coordinate for this body segment. This is UINT*_T to save 
-                        // RAM, could overflow with larger displays
-    snakeNode_t *next;  // the next in the linked list
-  };
-
-  snakeNode_t *_head;     // the head segment of the snake
-  snakeNode_t *_tail;     // the tail segment of the snake
-  snakeNode_t *_deleted;  // deleted blocks list
+  uint16_t _body[SNAKE_SIZE_MAX];  // ring buffer of body segment cells
+  uint16_t _head;         // index of the head segment in _body
+  uint16_t _length;       // number of body segments
   int8_t   _dx, _dy;      // the movement offsets for the x and y direction
   uint32_t _timeLastMove; // last time the snake was moved
   uint16_t _moveDelay;    // the delay between moves in milliseconds
@@ -198,75 +211,43 @@ private:
   void draw(uint16_t x, uint16_t y)  { mp.setPoint(x, y, true); } 
   void erase(uint16_t x, uint16_t y) { mp.setPoint(x, y, false); }
 
-  snakeNode_t *add(uint16_t x, uint16_t y)
-  // add a body segment to the tail
-  // the list is stored from tail to head
+  void addHead(uint16_t x, uint16_t y)
+  // add a body segment in front of the head
   {
-    snakeNode_t *psn;
-    
-    if (_deleted == nullptr)
-      psn = new snakeNode_t;
-    else
-    {
-      // take one from the head of the deleted list
-      psn = _deleted;
-      _deleted = _deleted->next;
-    }
+    uint16_t c = grid.cell(x, y);
 
-    if (psn != nullptr)
-    {
-      psn->x = x;
-      psn->y = y;
-      if (_tail == nullptr)
-      {
-        psn->next = nullptr;
-        _head = _tail = psn;    // the first segment
-        PRINTS("\n-- SNAKE added first element");
-      }
-      else
-      {
-        psn->next = _tail;
-        _tail = psn;
-        PRINTS("\n-- SNAKE added element");
-      }
-    }
-    return(psn);
+    _head = (_head + 1) % SNAKE_SIZE_MAX;
+    _body[_head] = c;
+    _length++;
+    grid.set(c, true);
+    draw(x, y);
   }
 
-  void deleteAll()
-  // delete all the body segments in the snake
+  void deleteTail(void)
+  // remove the tail body segment
   {
-    snakeNode_t *psn;
-    uint16_t count = 0;
-
-    while (_tail != nullptr)
-    {
-      // adjust the linked list by consuming from the tail
-      psn = _tail;
-      _tail = _tail->next;
-
-      // put the block in the deleted list
-      psn->next = _deleted;
-      _deleted = psn;
-
-      count++;
-    }
-    _head = nullptr;
+    uint16_t c = getTail();
 
-    PRINT("\n-- SNAKE nodes deleted: ", count);
+    _length--;
+    grid.set(c, false);
+    erase(grid.cellX(c), grid.cellY(c));
   }
 
 public:
   enum moveType_t { MOVE_UP, MOVE_DOWN, MOVE_LEFT, MOVE_RIGHT };
 
-  uint16_t getHeadX(void) { return (_head->x); }
-  uint16_t getHeadY(void) { return (_head->y); }
+  uint16_t getHead(void) { return (_body[_head]); }
+  uint16_t getTail(void) { return (_body[(_head + SNAKE_SIZE_MAX - (_length - 1)) % SNAKE_SIZE_MAX]); }
+  uint16_t getHeadX(void) { return (grid.cellX(_body[_head])); }
+  uint16_t getHeadY(void) { return (grid.cellY(_body[_head])); }
+  uint16_t getLength(void) { return (_length); }
 
   uint16_t getDelay(void) { return (_moveDelay); }
   void setDelay(uint16_t delay) { if (delay > 10) _moveDelay = delay; }
 
   void start(void) { _run = true; }
   void stop(void)  { _run = false; }
+  bool moveDue(void) { return (!_run || millis() - _timeLastMove > _moveDelay); }
 
   void setDirection(moveType_t d)
   {
@@ -280,13 +261,13 @@ public:
   }
 
   void reset(uint16_t x, uint16_t y)
+  // start a new snake with the head at x, y
+  // the grid must be reset first, as the old body is not removed
   {
-    deleteAll();
-    for (uint8_t i = 0; i < SNAKE_SIZE_DEFAULT; i++)
-    {
-      snakeNode_t *psn = add(x - i, y);
-      if (psn != nullptr) draw(psn->x, psn->y);
-    }
+    _head = 0;
+    _length = 0;
+    for (uint8_t i = SNAKE_SIZE_DEFAULT; i > 0; i--)
+      addHead(x - (i - 1), y);
     setDirection(MOVE_RIGHT);
     _pFoodCount->reset();
   }
@@ -300,64 +281,36 @@ public:
     _run = false;
     _pFoodCount = pFoodCount;
     _pFoodCount->reset();
-    _deleted = nullptr;
+    _head = _length = 0;
   }
 
   bool move(void)
-  // return true if something was hit
+  // return true if the wall or the snake was hit
   { 
     // if this is the time for a move? 
-    if (_run && millis() - _timeLastMove <= _moveDelay)
+    if (!moveDue())
       return(false);
     _timeLastMove = millis();
 
-    // do the animation
-    snakeNode_t *psn = _tail;
-    bool hitSomething = false;
+    uint16_t x = getHeadX() + _dx;
+    uint16_t y = getHeadY() + _dy;
 
-    // check if we would be colliding with the snake body
-    while (psn != nullptr && !hitSomething)
+    // check if we would be colliding with a wall or the snake body
+    if (grid.get(grid.cell(x, y)))
     {
-      hitSomething = (psn->x == _head->x + _dx && psn->y == _head->y + _dy);
-      psn = psn->next;
+      PRINTS("\n-! COLLIDE");
+      return(true);
     }
-    if (hitSomething) PRINTS("\n-! COLLIDE snake");
 
-    if (!hitSomething)
-    {
-      psn = _tail;    // reset back to the start of the data
-
-      // do we need to add one?
-      if (_pFoodCount->score() != 0)
-      {
-        add(_tail->x, _tail->y);  // make a copy of the tail
-        _pFoodCount->decrement();
-      }
-      else    // delete the tail on the display
-        erase(_tail->x, _tail->y);
-
-      while (psn != nullptr)
-      {
-        if (psn->next != nullptr) // main body segment
-        {
-          psn->x = psn->next->x;
-          psn->y = psn->next->y;
-        }
-        else      // the head
-        {
-          psn->x += _dx;
-          psn->y += _dy;
-          // check if this is already used
-          hitSomething = (mp.getPoint(psn->x, psn->y));
-          draw(psn->x, psn->y);
-        }
-        psn = psn->next;
-      }
-
-      if (hitSomething) PRINTS("\n-! COLLIDE not snake");
-    }
+    // do we need to grow one? If not the tail moves up
+    if (_pFoodCount->score() != 0 && _length < SNAKE_SIZE_MAX)
+      _pFoodCount->decrement();
+    else
+      deleteTail();
+
+    addHead(x, y);
 
-    return(hitSomething);
+    return(false);
   }
 };
 
@@ -367,10 +320,18 @@ cPill pill;
 cSnake snake;
 cMoveSW moveSW;
 cSound sound;
+cSnakeAI<GRID_CELLS, SEARCH_QUEUE> ai;
+bool demoOK;      // the autopilot can play in this field
 
 void setupField(void)
-// Draw the playing field at the start of the game.
+// Draw the playing field at the start of the game and mark all the cells 
+// outside the playing field as in use.
 {
+  grid.fill(true);
+  for (uint16_t y = FIELD_BOTTOM + 1; y < FIELD_TOP; y++)
+    for (uint16_t x = FIELD_LEFT + 1; x < FIELD_RIGHT; x++)
+      grid.set(grid.cell(x, y), false);
+
   mp.clear();
   mp.drawHLine(FIELD_TOP, FIELD_LEFT, FIELD_RIGHT);
   mp.drawHLine(FIELD_BOTTOM, FIELD_LEFT, FIELD_RIGHT);
@@ -397,7 +358,10 @@ void setup()
   // one time initialization
   FIELD_TOP = mp.getYMax() - mp.getFontHeight() - 2;
   FIELD_RIGHT = mp.getXMax();
-  pill.begin(FIELD_LEFT + 1, FIELD_BOTTOM + 1, FIELD_RIGHT - 1, FIELD_TOP - 1);
+  if (!grid.begin(mp.getXMax() + 1, mp.getYMax() + 1)) PRINTS("\nGrid is too small for the display.");
+  pill.begin();
+  demoOK = ai.begin(FIELD_LEFT + 1, FIELD_BOTTOM + 1, FIELD_RIGHT - FIELD_LEFT - 1, FIELD_TOP - FIELD_BOTTOM - 1);
+  if (!demoOK) PRINTS("\nNo demo, the field needs an even side.");
   food.begin(&mp, FIELD_LEFT + 1, FIELD_TOP + 1 + mp.getFontHeight(), MAX_FOOD);
 
   sound.begin(BEEPER_PIN);
@@ -424,9 +388,49 @@ bool doSwitches(void)
   return(b);
 }
 
+void handleDemo(void)
+// steer the snake to the cell chosen by the autopilot
+{
+  if (!snake.moveDue())
+    return;
+
+  uint16_t c = ai.next(grid, snake.getHead(), snake.getTail(), grid.cell(pill.getX(), pill.getY()), food.score() + PILL_VALUE_MAX);
+
+  if (c == ai.NO_CELL)
+    return;   // nowhere to go
+
+  if (grid.cellX(c) > snake.getHeadX())
+    snake.setDirection(cSnake::MOVE_RIGHT);
+  else if (grid.cellX(c) < snake.getHeadX())
+    snake.setDirection(cSnake::MOVE_LEFT);
+  else if (grid.cellY(c) > snake.getHeadY())
+    snake.setDirection(cSnake::MOVE_UP);
+  else
+    snake.setDirection(cSnake::MOVE_DOWN);
+}
+
+bool moveSnake(void)
+// move the snake and eat the pill if it is reached, return false if the
+// snake has hit the wall or itself
+{
+  if (snake.move())
+    return(false);
+
+  if (snake.getHeadX() == pill.getX() && snake.getHeadY() == pill.getY()) // have we hit the pill?
+  {
+    sound.hit();
+    score.increment(pill.getValue());
+    food.increment(pill.getValue());
+    pill.reset();
+  }
+
+  return(true);
+}
+
 void loop(void)
 {
-  static enum { S_SPLASH, S_INIT, S_WAIT_START, S_POINT_PLAY, S_GAME_OVER } runState = S_SPLASH;
+  static enum { S_SPLASH, S_INIT, S_WAIT_START, S_POINT_PLAY, S_DEMO, S_GAME_OVER } runState = S_SPLASH;
+  static uint32_t timeStart;    // time waiting for the start of a game
 
   switch (runState)
   {
@@ -456,6 +460,7 @@ void loop(void)
     setupField();
     snake.reset((FIELD_RIGHT - FIELD_LEFT) / 2, (FIELD_TOP - FIELD_BOTTOM) / 2);
     pill.reset();
+    timeStart = millis();
 
     runState = S_WAIT_START;
     PRINTSTATE("WAIT_START");
@@ -470,6 +475,13 @@ void loop(void)
       runState = S_POINT_PLAY;
       PRINTSTATE("POINT_PLAY");
     }
+    else if (demoOK && millis() - timeStart >= DEMO_DELAY)
+    {
+      PRINTS("\n-- Starting Demo");
+      snake.start();
+      runState = S_DEMO;
+      PRINTSTATE("DEMO");
+    }
     break;
 
   case S_POINT_PLAY:    // playing a point
@@ -477,20 +489,27 @@ void loop(void)
     doSwitches();
 
     // move snake and check what this means
-    if (snake.move())
+    if (!moveSnake())   // we have hit the wall or ourselves
+    {
+      snake.stop();
+      runState = S_GAME_OVER;
+    }
+    break;
+
+  case S_DEMO:    // playing itself until a switch is pressed
+    if (moveSW.anyKey())
+    {
+      snake.stop();
+      runState = S_INIT;
+      break;
+    }
+
+    handleDemo();
+
+    if (!moveSnake())
     {
-      if (snake.getHeadX() == pill.getX() && snake.getHeadY() == pill.getY()) // have we hit the pill?
-      {
-        sound.hit();
-        score.increment(pill.getValue());
-        food.increment(pill.getValue());
-        pill.reset();
-      }
-      else    // we have hit the wall or ourselves
-      {
-        snake.stop();
-        runState = S_GAME_OVER;
-      }
+      snake.stop();
+      runState = S_GAME_OVER;
     }
     break;
 
@@ -11,13 +11,14 @@ private:
   uint16_t _x, _y;    // coordinate of top left for display
   uint8_t _width;     // number of digits wide
   uint16_t _limit;    // maximum value allowed
+  char _last[6];      // digits last displayed, to only redraw the changes
 
 public:
   void begin(MD_MAXPanel *mp, uint16_t x, uint16_t y, uint16_t maxScore) { _mp = mp;  _x = x, _y = y; limit(maxScore); reset(); }
   void reset(void)       { erase(); _score = 0; draw(); }
-  void set(uint16_t s)   { if (s <= _limit) { erase(); _score = s; draw(); } }
-  void increment(uint16_t inc = 1) { if (_score + inc <= _limit) { erase(); _score += inc; draw(); } }
-  void decrement(uint16_t dec = 1) { if (_score >= dec) { erase(); _score -= dec; draw(); } }
+  void set(uint16_t s)   { if (s <= _limit) { _score = s; redraw(); } }
+  void increment(uint16_t inc = 1) { if (_score + inc <= _limit) { _score += inc; redraw(); } }
+  void decrement(uint16_t dec = 1) { if (_score >= dec) { _score -= dec; redraw(); } }
   uint16_t score(void)   { return(_score); }
   void erase(void)       { draw(false); }
   uint16_t width(void)   { return(_width); }
@@ -37,18 +38,21 @@ public:
   }
 
   void draw(bool state = true)
+  // draw all the digits
   {
-    char sz[_width + 1];
-    uint16_t s = _score;
+    if (_width == 0) return;   // limit() not called yet
 
     // PRINT("\n-- SCORE: ", _score);
-    sz[_width] = '\0';
-    for (int i = _width - 1; i >= 0; --i)
-    {
-      sz[i] = (s % 10) + '0';
-      s /= 10;
-    }
+    _last[0] = '\0';
+    if (state)
+      _mp->drawNumberChanges(_x, _y, _score, _last, _width, '0');
+    else
+      _mp->drawNumber(_x, _y, _score, _width, '0', 10, MD_MAXPanel::ROT_0, false);
+  }
 
-    _mp->drawText(_x, _y, sz, MD_MAXPanel::ROT_0, state);
+  void redraw(void)
+  // only draw the digits that changed since the last draw
+  {
+    _mp->drawNumberChanges(_x, _y, _score, _last, _width, '0');
   }
 };
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "snakeGrid.h"
+
+// A first-in first-out queue of up to SIZE items held in a fixed array, so
+// it can be used over and over without any memory being allocated.
+template <typename T, uint16_t SIZE>
+class cQueue
+{
+public:
+  void clear(void) { _head = _count = 0; }
+  bool empty(void) { return(_count == 0); }
+
+  bool push(T t)
+  // add t to the back of the queue, return false if the queue is full
+  {
+    if (_count == SIZE)
+      return(false);
+
+    _item[(_head + _count) % SIZE] = t;
+    _count++;
+    return(true);
+  }
+
+  T pop(void)
+  // remove and return the item at the front of the queue, which must not
+  // be empty
+  {
+    T t = _item[_head];
+
+    _head = (_head + 1) % SIZE;
+    _count--;
+    return(t);
+  }
+
+private:
+  T _item[SIZE];      // the queue items
+  uint16_t _head;     // index of the item at the front of the queue
+  uint16_t _count;    // number of items in the queue
+};
+
+// A class to choose the next move of the snake.
+//
+// The shortest path to the food is found by a breadth first search of the
+// free cells in the grid, working out from the food until one of the cells
+// next to the head is reached, so the first step of the path is known
+// without keeping the path. The search queue holds QUEUE cells and the
+// search gives up if it fills.
+//
+// To keep the snake out of trouble, every cell of the field is also given
+// an order along a Hamiltonian cycle, a path through the field that visits
+// each cell once and returns to the start, worked out from the cell
+// coordinates rather than held in a table. The cycle runs up the first
+// column, snakes down and up the rest of the columns above the first row,
+// and back along the first row, so one side of the field must be an even
+// number of cells long. A snake that keeps its body in cycle order from the
+// tail to the head can always follow the cycle without hitting itself, so
+// the step towards the food is only taken if it does not jump past the food
+// or the tail in cycle order, leaving room for the snake to grow, and leaves
+// a run of free cells ahead on the cycle longer than the snake, so the gaps
+// left behind by the shortcuts are not needed as the field fills. Otherwise
+// the snake takes the next cell on the cycle, so it always reaches the food
+// within one lap of the cycle.
+//
+// The grid cells around the field must be in use, as the search does not
+// check the edges of the grid.
+template <uint16_t CELLS, uint16_t QUEUE>
+class cSnakeAI
+{
+public:
+  static const uint16_t NO_CELL = 0xffff;   // no move is possible
+
+  typedef cSnakeGrid<CELLS> grid_t;
+
+  bool begin(uint16_t x0, uint16_t y0, uint16_t width, uint16_t height)
+  // Set the field as the rectangle width by height cells with the bottom
+  // left cell at x0, y0. Return false if there is no cycle for the field.
+  {
+    if (width < 2 || height < 2 || ((width & 1) && (height & 1)))
+      return(false);
+
+    _x0 = x0;
+    _y0 = y0;
+    _width = width;
+    _height = height;
+    resetCount();
+
+    return(true);
+  }
+
+  uint32_t overflows(void) { return(_overflows); }   // searches that filled the queue since resetCount()
+  uint16_t searched(void) { return(_searched); }     // cells taken from the queue by the last search
+  void resetCount(void) { _overflows = 0; }
+
+  uint16_t next(grid_t &g, uint16_t head, uint16_t tail, uint16_t food, uint16_t grow)
+  // Return the cell for the next move of the snake from head to the food,
+  // where the snake can still grow by up to grow cells before the tail
+  // moves again, or NO_CELL if all the cells next to the head are in use.
+  {
+    uint16_t gap = distance(g, head, tail);   // cells to the tail along the cycle
+    uint16_t c = search(g, head, food);
+
+    if (c != NO_CELL)
+    {
+      uint16_t d = distance(g, head, c);
+
+      if (d <= distance(g, head, food) && d + grow < gap && gap - d > (_width * _height) - g.freeCells())
+        return(c);
+    }
+
+    // follow the cycle
+    c = successor(g, head);
+    if (c != NO_CELL && !g.get(c))
+      return(c);
+
+    // the body is out of cycle order, take any free cell
+    uint16_t n[4];
+
+    neighbours(g, head, n);
+    for (uint8_t i = 0; i < 4; i++)
+      if (!g.get(n[i]))
+        return(n[i]);
+
+    return(NO_CELL);
+  }
+
+private:
+  uint16_t _x0, _y0;            // bottom left cell of the field
+  uint16_t _width, _height;     // size of the field
+  uint32_t _overflows;          // searches that filled the queue
+  uint16_t _searched;           // cells searched by the last search
+  uint8_t _seen[(CELLS + 7) / 8];   // cells reached by the search
+  cQueue<uint16_t, QUEUE> _queue;   // cells still to be searched from
+
+  void neighbours(grid_t &g, uint16_t c, uint16_t n[4])
+  // set n to the cells next to c
+  {
+    n[0] = c + 1;
+    n[1] = c - 1;
+    n[2] = c + g.width();
+    n[3] = c - g.width();
+  }
+
+  uint16_t search(grid_t &g, uint16_t head, uint16_t food)
+  // return the cell next to the head on a shortest path to the food, or
+  // NO_CELL if there is no path or the queue fills
+  {
+    memset(_seen, 0, sizeof(_seen));
+    _queue.clear();
+    _searched = 0;
+
+    _seen[food / 8] |= (1 << (food % 8));
+    _queue.push(food);
+
+    while (!_queue.empty())
+    {
+      uint16_t c = _queue.pop();
+      uint16_t n[4];
+
+      _searched++;
+      neighbours(g, c, n);
+      for (uint8_t i = 0; i < 4; i++)
+      {
+        if (n[i] == head)
+          return(c);
+
+        if (g.get(n[i]) || (_seen[n[i] / 8] & (1 << (n[i] % 8))))
+          continue;
+
+        _seen[n[i] / 8] |= (1 << (n[i] % 8));
+        if (!_queue.push(n[i]))
+        {
+          _overflows++;
+          return(NO_CELL);
+        }
+      }
+    }
+
+    return(NO_CELL);
+  }
+
+  bool inField(grid_t &g, uint16_t c)
+  {
+    uint16_t x = g.cellX(c), y = g.cellY(c);
+
+    return(x >= _x0 && x < _x0 + _width && y >= _y0 && y < _y0 + _height);
+  }
+
+  uint16_t order(grid_t &g, uint16_t c)
+  // return the position of field cell c along the cycle
+  {
+    uint16_t x = g.cellX(c) - _x0, y = g.cellY(c) - _y0;
+    uint16_t w = _width, h = _height;
+
+    // the columns run along the odd side if the width is odd
+    if (w & 1)
+    {
+      uint16_t t;
+
+      t = x; x = y; y = t;
+      t = w; w = h; h = t;
+    }
+
+    if (x == 0)       // up the first column
+      return(y);
+    if (y == 0)       // back along the first row
+      return((w * h) - x);
+
+    // down the odd columns and up the even ones
+    return(h + ((x - 1) * (h - 1)) + ((x & 1) ? h - 1 - y : y - 1));
+  }
+
+  uint16_t distance(grid_t &g, uint16_t from, uint16_t to)
+  // return the number of steps along the cycle between two field cells
+  {
+    uint16_t n = _width * _height;
+
+    return((order(g, to) + n - order(g, from)) % n);
+  }
+
+  uint16_t successor(grid_t &g, uint16_t c)
+  // return the cell after c on the cycle
+  {
+    uint16_t n[4];
+
+    neighbours(g, c, n);
+    for (uint8_t i = 0; i < 4; i++)
+      if (inField(g, n[i]) && distance(g, c, n[i]) == 1)
+        return(n[i]);
+
+    return(NO_CELL);
+  }
+};
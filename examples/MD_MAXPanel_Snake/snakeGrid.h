@@ -0,0 +1,95 @@
+#pragma once
+
+// A class to encapsulate the occupancy of the display cells.
+//
+// Each display cell has a bit that is set when the cell is in use by the
+// snake or a wall, so a collision is found by testing one bit rather than
+// reading back the display. A cell is packed into a single number,
+// (y * width) + x, which is what the snake keeps for each body segment.
+//
+// The number of free cells is kept as the bits change, so a free cell can
+// be picked at random with one call to random() and found by select(),
+// which counts through the free bits a byte at a time. This takes the same
+// time however crowded the display is.
+template <uint16_t CELLS>
+class cSnakeGrid
+{
+public:
+  bool begin(uint16_t width, uint16_t height)
+  // set the size of the grid, return false if it is too big
+  {
+    if ((uint32_t)width * height > CELLS)
+      return(false);
+
+    _width = width;
+    _height = height;
+    _cells = width * height;
+    fill(true);
+
+    return(true);
+  }
+
+  uint16_t width(void) { return(_width); }
+  uint16_t height(void) { return(_height); }
+  uint16_t freeCells(void) { return(_free); }   // number of free cells
+
+  uint16_t cell(uint16_t x, uint16_t y) { return((y * _width) + x); }
+  uint16_t cellX(uint16_t c) { return(c % _width); }
+  uint16_t cellY(uint16_t c) { return(c / _width); }
+
+  bool get(uint16_t c) { return((_bits[c / 8] >> (c % 8)) & 1); }
+
+  void set(uint16_t c, bool b)
+  // set the cell in use (b true) or free
+  {
+    uint8_t *p = &_bits[c / 8];
+    uint8_t mask = (1 << (c % 8));
+
+    if (((*p & mask) != 0) == b)
+      return;
+
+    if (b) { *p |= mask; _free--; }
+    else   { *p &= ~mask; _free++; }
+  }
+
+  void fill(bool b)
+  // set all the cells in use (b true) or free
+  {
+    memset(_bits, b ? 0xff : 0, sizeof(_bits));
+    _free = b ? 0 : _cells;
+
+    // the bits past the last cell are always in use
+    if (_cells % 8 != 0)
+      _bits[_cells / 8] |= (0xff << (_cells % 8));
+  }
+
+  uint16_t select(uint16_t r)
+  // return the cell that is free cell number r, counting from 0, where r 
+  // is less than freeCells()
+  {
+    uint16_t i = 0;
+    uint8_t f;
+
+    // skip the bytes with r or fewer free cells
+    for ( ; ; i++)
+    {
+      uint8_t n;
+
+      f = ~_bits[i];
+      n = __builtin_popcount(f);
+      if (r < n) break;
+      r -= n;
+    }
+
+    // find the free bit in this byte
+    for (uint8_t b = 0; ; b++, f >>= 1)
+      if ((f & 1) && r-- == 0)
+        return((i * 8) + b);
+  }
+
+private:
+  uint8_t _bits[(CELLS + 7) / 8];   // bit set for each cell in use
+  uint16_t _width, _height;         // size of the grid
+  uint16_t _cells;                  // number of cells in the grid
+  uint16_t _free;                   // number of free cells
+};
@@ -168,8 +168,7 @@ bool detectSwitch(swState_t *ss)
 
 void userMessage(char *psz)
 {
-  mp.clear(1, 0, mp.getXMax(), USER_MESG);
-  mp.drawText(1, USER_MESG, psz, MD_MAXPanel::ROT_0, true);
+  mp.drawTextBox(1, 0, mp.getXMax(), USER_MESG, psz);
 }
 
 uint8_t getMove(void)
@@ -0,0 +1,26 @@
+#pragma once
+
+// Packed font generated by FontPack from Font5x3.h
+// 299 bytes (MD_MAX72xx font 365 bytes), 5 bit columns, 1 range
+const uint8_t _Fixed_5x3_Packed[] PROGMEM =
+{
+  0x50, 0x01, 0x05, 0x03, 0x05, 0x00, 0x01, 0x00, 0x20, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x13, 0x00, 0x26, 0x00, 0x3e, 0x00, 0x53, 0x00, 0x6b, 0x00, 0x83, 0x00, 0x9b, 0x00, 0xb1, 0x00,
+  0xc8, 0x00, 0xdb, 0x00, 0xf2, 0x00, 0x02, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x02, 0x02,
+  0x03, 0x03, 0x02, 0x03, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+  0x01, 0x02, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+  0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+  0x03, 0x02, 0x03, 0x02, 0x03, 0x03, 0x02, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01,
+  0x02, 0x03, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x02, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+  0x03, 0x03, 0x01, 0x03, 0x03, 0x03, 0x00, 0x2e, 0x30, 0x0f, 0xea, 0xfd, 0xbe, 0xd4, 0x92, 0x4a,
+  0xae, 0x86, 0xe8, 0xc5, 0xca, 0x22, 0x88, 0xe2, 0x41, 0x04, 0x21, 0x20, 0x82, 0x0b, 0xf1, 0xf8,
+  0x3e, 0x0e, 0xd6, 0xf1, 0xaf, 0xce, 0x4f, 0xde, 0xbd, 0xfd, 0x7a, 0x10, 0xff, 0xf5, 0xfd, 0xeb,
+  0xf5, 0x41, 0x44, 0x54, 0x54, 0xa5, 0x45, 0x44, 0x0d, 0x46, 0xea, 0xdb, 0xc5, 0xf7, 0xea, 0xa7,
+  0x46, 0x3f, 0x8b, 0xbf, 0x58, 0xfc, 0xa1, 0x74, 0x7b, 0xf2, 0x7e, 0x3f, 0x8a, 0x20, 0xff, 0x93,
+  0x7f, 0x84, 0x3e, 0x2f, 0xfd, 0xdf, 0x74, 0x5d, 0xf2, 0x89, 0xd9, 0xf7, 0xcb, 0xa9, 0x55, 0x21,
+  0xf8, 0x5f, 0x07, 0x9f, 0x07, 0x7f, 0x1f, 0xb2, 0x6c, 0x7c, 0x1e, 0x6b, 0x3f, 0xc4, 0x44, 0x44,
+  0x7e, 0x20, 0x8a, 0x10, 0x80, 0x44, 0xc9, 0x73, 0xf2, 0x63, 0x25, 0x26, 0x4b, 0xec, 0xd5, 0x09,
+  0xf2, 0xd3, 0x4c, 0xf8, 0xb9, 0xd8, 0x37, 0xe8, 0xa7, 0xfc, 0x6f, 0x78, 0x5c, 0x64, 0x99, 0xe5,
+  0x10, 0x8a, 0xf7, 0x89, 0x4f, 0x28, 0x9e, 0x23, 0xa1, 0xe7, 0x41, 0xce, 0xc3, 0xa4, 0xc9, 0x5b,
+  0x0e, 0xd7, 0xac, 0x4d, 0xc7, 0x71, 0xd9, 0x0c, 0x21, 0xff, 0xff,
+};
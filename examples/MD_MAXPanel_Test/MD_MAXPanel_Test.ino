@@ -9,6 +9,7 @@
 
 #include <MD_MAXPanel.h>
 #include "Font5x3.h"
+#include "Font5x3_Packed.h"
 
 // Turn on debug statements to the serial output
 #define  DEBUG  1
@@ -44,6 +45,8 @@ MD_MAXPanel mp = MD_MAXPanel(HARDWARE_TYPE, CS_PIN, X_DEVICES, Y_DEVICES);
 // We always wait a bit between updates of the display
 #define  DELAYTIME  100  // in milliseconds
 
+#define ARRAY_SIZE(a) (sizeof(a)/sizeof((a)[0]))
+
 void zeroPointer(void)
 // Demonstrates the use of setPoint and
 // show where the zero point is in the display
@@ -228,6 +231,52 @@ void rectangles(void)
   }
 }
 
+void roundRectangles(void)
+// Demonstrate the use of drawRoundRect() and drawFillRoundRect()
+// Nested rounded rectangles with increasing corner radius
+{
+  PRINTS("\nRounded Rectangles");
+  mp.clear();
+
+  for (uint8_t r = 1; r < 6; r++)
+  {
+    for (uint16_t i = 0; i < min(mp.getXMax(), mp.getYMax()) / 2; i += 3)
+      mp.drawRoundRect(i, i, mp.getXMax() - i, mp.getYMax() - i, r, true);
+    delay(5 * DELAYTIME);
+    mp.clear();
+  }
+
+  for (uint16_t i = 0; i < min(mp.getXMax(), mp.getYMax()) / 2; i += 2)
+  {
+    mp.drawFillRoundRect(i, i, mp.getXMax() - i, mp.getYMax() - i, i + 1, true);
+    delay(2 * DELAYTIME);
+    mp.drawFillRoundRect(i, i, mp.getXMax() - i, mp.getYMax() - i, i + 1, false);
+  }
+}
+
+void thickLines(void)
+// Demonstrate the use of drawThickLine()
+// Rotating line through the center with increasing width
+{
+  const uint16_t xc = mp.getXMax() / 2;
+  const uint16_t yc = mp.getYMax() / 2;
+
+  PRINTS("\nThick Lines");
+  mp.clear();
+
+  for (uint8_t w = 2; w < 6; w++)
+  {
+    for (uint16_t x = 0; x <= mp.getXMax(); x += 4)
+    {
+      mp.drawThickLine(x, 0, mp.getXMax() - x, mp.getYMax(), w, true);
+      delay(DELAYTIME);
+      mp.drawThickLine(x, 0, mp.getXMax() - x, mp.getYMax(), w, false);
+    }
+  }
+  mp.drawThickLine(xc, yc, xc, yc, 5, true);
+  delay(5 * DELAYTIME);
+}
+
 void quadrilaterals(void)
 // Demonstrate the use of drawQuadrilateral()
 // Rubber band quadrilaterals anchored to the display edge
@@ -350,6 +399,89 @@ void circles(void)
   }
 }
 
+void curves(void)
+// Demonstrate the use of drawQuadBezier(), drawCubicBezier() and drawSpline()
+// Curves anchored to the display corners and a wave across the display
+{
+  const uint8_t NUM_CURVES = 10;
+  const uint8_t NUM_POINTS = 5;
+  uint16_t x[NUM_POINTS], y[NUM_POINTS];
+
+  PRINTS("\nCurves");
+  mp.clear();
+
+  for (uint8_t i = 0; i < NUM_CURVES; i++)
+  {
+    uint16_t cx = random(mp.getXMax() + 1);
+    uint16_t cy = random(mp.getYMax() + 1);
+
+    mp.drawQuadBezier(0, 0, cx, cy, mp.getXMax(), 0, true);
+    mp.drawCubicBezier(0, mp.getYMax(), cx, 0, mp.getXMax() - cx, cy, mp.getXMax(), mp.getYMax(), true);
+    delay(2 * DELAYTIME);
+    mp.clear();
+  }
+
+  for (uint8_t i = 0; i < NUM_POINTS; i++)
+  {
+    x[i] = (i * mp.getXMax()) / (NUM_POINTS - 1);
+    y[i] = (i & 1) ? mp.getYMax() / 4 : (3 * mp.getYMax()) / 4;
+  }
+  mp.drawSpline(NUM_POINTS, x, y, true);
+  delay(5 * DELAYTIME);
+}
+
+void floodFills(void)
+// Demonstrate the use of floodFill()
+// Fill the areas of overlapping outlines one at a time
+{
+  const uint16_t xc = mp.getXMax() / 2;
+  const uint16_t yc = mp.getYMax() / 2;
+  const uint16_t r = min(mp.getXMax(), mp.getYMax()) / 3;
+
+  PRINTS("\nFlood Fill");
+  mp.clear();
+
+  mp.drawRectangle(0, 0, mp.getXMax(), mp.getYMax(), true);
+  mp.drawCircle(xc, yc, r, true);
+  mp.drawLine(0, 0, mp.getXMax(), mp.getYMax(), true);
+  delay(5 * DELAYTIME);
+
+  mp.floodFill(xc, yc - 2, true);       // one half of the circle
+  delay(5 * DELAYTIME);
+  mp.floodFill(1, mp.getYMax() - 2, true); // outside the circle, top left
+  delay(5 * DELAYTIME);
+  mp.floodFill(xc, yc - 2, false);      // erase the half circle again
+  delay(5 * DELAYTIME);
+}
+
+void patternFills(void)
+// Demonstrate the use of fill patterns and getBayerPattern()
+// Fade a circle in and out over a checkerboard filled rectangle
+{
+  const uint16_t xc = mp.getXMax() / 2;
+  const uint16_t yc = mp.getYMax() / 2;
+  const uint16_t r = min(mp.getXMax(), mp.getYMax()) / 3;
+  uint8_t pattern[8];
+
+  PRINTS("\nPattern Fill");
+  mp.clear();
+
+  mp.drawFillRectangle(0, 0, mp.getXMax(), mp.getYMax(), true, mp.getBayerPattern(pattern, 32));
+  delay(5 * DELAYTIME);
+
+  for (uint8_t level = 0; level <= 64; level += 4)
+  {
+    mp.drawFillCircle(xc, yc, r, true, mp.getBayerPattern(pattern, level));
+    delay(DELAYTIME);
+  }
+  for (uint8_t level = 0; level <= 64; level += 4)
+  {
+    mp.drawFillCircle(xc, yc, r, false, mp.getBayerPattern(pattern, level));
+    delay(DELAYTIME);
+  }
+  delay(5 * DELAYTIME);
+}
+
 void bounce(void)
 // Animation of a bouncing ball
 {
@@ -405,6 +537,54 @@ void text(MD_MAX72XX::fontType_t *fontData)
   mp.clear();
   mp.drawText(mp.getXMax(), mp.getYMax(), "R_270", MD_MAXPanel::ROT_270);
   delay(5 * DELAYTIME);
+
+  // transparent text over a dithered background
+  uint8_t pattern[8];
+
+  mp.clear();
+  mp.drawFillRectangle(0, 0, mp.getXMax(), mp.getYMax(), true, mp.getBayerPattern(pattern, 16));
+  mp.setTextTransparent(true);
+  mp.drawText(0, mp.getYMax(), "Clear", MD_MAXPanel::ROT_0);
+  mp.setTextTransparent(false);
+  delay(5 * DELAYTIME);
+
+  // the same font scaled up
+  for (uint8_t scale = 2; scale <= 4; scale++)
+  {
+    mp.clear();
+    mp.drawText(0, mp.getYMax(), "42", MD_MAXPanel::ROT_0, true, scale);
+    delay(5 * DELAYTIME);
+  }
+
+  // word wrapped text in a box, each alignment in turn
+  const MD_MAXPanel::textAlign_t align[] = { MD_MAXPanel::ALIGN_LEFT, MD_MAXPanel::ALIGN_CENTER, MD_MAXPanel::ALIGN_RIGHT };
+
+  for (uint8_t i = 0; i < ARRAY_SIZE(align); i++)
+  {
+    mp.clear();
+    mp.drawRectangle(0, 0, mp.getXMax(), mp.getYMax());
+    mp.drawTextBox(2, 2, mp.getXMax() - 2, mp.getYMax() - 2, "Text wraps in a box", align[i]);
+    delay(5 * DELAYTIME);
+  }
+}
+
+void packedText(void)
+// Demonstrate the use of setPackedFont()
+// Display text using the packed version of the 5x3 font
+{
+  PRINTS("\nPacked Text");
+
+  if (!mp.setPackedFont(_Fixed_5x3_Packed))
+  {
+    PRINTS(" - not a packed font");
+    return;
+  }
+
+  mp.clear();
+  mp.drawText(0, mp.getYMax(), "Packed", MD_MAXPanel::ROT_0);
+  delay(5 * DELAYTIME);
+
+  mp.setFont(nullptr);
 }
 
 void setup(void)
@@ -423,18 +603,24 @@ void loop(void)
   showUp();
   brightness();
   lines();
+  thickLines();
   hLines();
   vLines();
   rectangles();
   rectanglesFill();
+  roundRectangles();
   circles();
   circlesFill();
   triangles();
   trianglesFill();
   quadrilaterals();
+  curves();
+  floodFills();
+  patternFills();
   bounce();
   text(_Fixed_5x3);
   text(nullptr);
+  packedText();
 
   // rotate the display and do it all again
   mp.setRotation(mp.getRotation() == MD_MAXPanel::ROT_0 ? MD_MAXPanel::ROT_90 : MD_MAXPanel::ROT_0);
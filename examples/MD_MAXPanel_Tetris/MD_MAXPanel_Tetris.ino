@@ -30,12 +30,22 @@
 // a new level. As the game progresses, each level causes the tetrominoes to fall 
 // faster, and the game ends when the stack of tetrominoes reaches the top of 
 // the playing field and no new tetrominos are able to enter.
+//
+// Demo Mode
+// =========
+// If no game is started for DEMO_DELAY the game plays itself, moving each 
+// piece to the place chosen by the auto-player in tetrisAI.h, until a switch 
+// is pressed. The auto-player tries every rotation and column of the piece, 
+// and of the next piece too if DEMO_LOOKAHEAD is true, which plays better but 
+// takes a noticeable time for each piece on slower boards.
 
 #include <MD_MAXPanel.h>
 #include "Font5x3.h"
 #include "score.h"
 #include "sound.h"
 #include "randomseed.h"
+#include "tetrisBoard.h"
+#include "tetrisAI.h"
 
 // Turn on debug statements to the serial output
 #define  DEBUG  0
@@ -102,6 +112,10 @@ const uint16_t MAX_SCORE = 60000;
 const uint16_t PIECE_SCORE = 5;
 const uint16_t LINE_SCORE = 20;
 
+const uint16_t DEMO_DELAY = 10000;     // idle time before the demo starts, in milliseconds
+const uint16_t DEMO_MOVE_TIME = 50;    // time between demo moves, in milliseconds
+const bool DEMO_LOOKAHEAD = false;     // demo also places the next piece
+
 #define ARRAY_SIZE(a) (sizeof(a)/sizeof(a[0]))
 
 // A class to encapsulate the snake direction switches
@@ -155,16 +169,20 @@ public:
 };
 
 // A class to encapsulate the Tetris field
+// The pieces and the well are held by cTetromino and cTetrisBoard
+// (tetrisBoard.h), which are shared with the auto-player.
 class cTetris
 {
-private:
-  const uint8_t OMINO_SIZE = 4;  // 4x4 field flattened out into 16 bits
+public:
+  typedef cTetrisBoard<FIELD_WIDTH, FIELD_HEIGHT> board_t;
 
-  const uint8_t MAX_ROTATE = 4;  // maximum number of rotations
+private:
+  static const uint8_t OMINO_SIZE = cTetromino::SIZE;
+  static const uint8_t MAX_ROTATE = cTetromino::MAX_ROTATE;
 
-  uint16_t _tetromino[7];        // tetronimoes, values initialized in the constructor
-  
-  bool _field[FIELD_WIDTH][FIELD_HEIGHT];
+  cTetromino _piece;      // tetronimo shapes
+  board_t _field;         // the well
+  uint16_t _shown[FIELD_HEIGHT];  // field rows as last shown on the display
 
   uint32_t _timeLastMove; // last time the snake was moved
   uint16_t _moveDelay;    // the delay between moves in milliseconds
@@ -174,7 +192,8 @@ private:
   uint8_t _curOmino;    // current tetronimo
   uint8_t _nxtOmino;    // the next tetronimo
   uint8_t _curRotation; // current rotated orientation
-  uint16_t _x, _y;      // _field coordinates for the piece
+  int16_t _x, _y;       // _field coordinates for the piece
+  uint32_t _pieces;     // number of pieces dealt
   cScore *_pScore;      // for keeping score
   cSound *_pSound;      // for making noise
 
@@ -187,11 +206,7 @@ private:
       PRINT("\n L", j); PRINTS(": ");
       for (int8_t i = 0; i < OMINO_SIZE; i++)
       {
-        // Get index into piece
-        int8_t idx = rotate(i, j, rot);
-
-        // draw the point
-        if ((_tetromino[omino] >> idx) & 1) { PRINTS(" 1") }
+        if ((_piece.row(omino, rot, j) >> i) & 1) { PRINTS(" 1") }
         else { PRINTS(" 0") }
       }
     }
@@ -207,18 +222,17 @@ private:
     mp.update(false);
     //dumpOmino(omino, rot);
     for (int8_t j = 0; j < OMINO_SIZE; j++)
-      for (int8_t i = 0; i < OMINO_SIZE; i++)
-      {
-        // Get index into piece
-        int8_t idx = rotate(i, j, rot);
+    {
+      uint8_t row = _piece.row(omino, rot, j);
 
+      for (int8_t i = 0; row != 0; i++, row >>= 1)
+      {
         // draw the point
         //PRINTXY(" ", FIELD_LEFT + x + i, FIELD_TOP - y - j);
-        //PRINT(" i", idx);
-        //PRINT(" v", (_tetromino[omino] >> idx) & 1);
-        if ((_tetromino[omino] >> idx) & 1)
+        if (row & 1)
           mp.setPoint(x + i, y - j, b);
       }
+    }
     mp.update(true);
   }
 
@@ -227,171 +241,53 @@ private:
   void drawOmino(uint8_t omino, uint8_t rot, int16_t x, int16_t y) { showOmino(omino, rot, FIELD_LEFT + x + 1, FIELD_TOP - y, true); }
   void eraseOmino(uint8_t omino, uint8_t rot, int16_t x, int16_t y) { showOmino(omino, rot, FIELD_LEFT + x + 1, FIELD_TOP - y, false); }
 
-  void omino2Field(uint8_t omino, uint8_t rot, int16_t x, int16_t y)
-  // copy the tetronimo to the field, leaving the rest untouched
-  {
-    for (int8_t j = 0; j < OMINO_SIZE; j++)
-    {
-      for (int8_t i = 0; i < OMINO_SIZE; i++)
-      {
-        // Get index into piece
-        int8_t idx = rotate(i, j, rot);
-
-        // set in field if set in tetronimo
-        if ((_tetromino[omino] >> idx) & 1)
-          _field[x + i][y + j] = true;
-      }
-    }
-  }
-
   void displayField(void)
-  // display the field, mindful of offsets in displayable field
+  // display the cells that changed since the field was last displayed, 
+  // mindful of offsets in displayable field
   {
     mp.update(false);
     for (uint8_t j = 0; j < FIELD_HEIGHT; j++)
-      for (uint8_t i = 0; i < FIELD_WIDTH; i++)
-        mp.setPoint(FIELD_LEFT+i+1, FIELD_TOP-j, _field[i][j]);
+    {
+      uint16_t cells = _field.cells(j);
+      uint16_t diff = cells ^ _shown[j];
+
+      for (uint8_t i = 0; diff != 0; i++, diff >>= 1)
+        if (diff & 1)
+          mp.setPoint(FIELD_LEFT+i+1, FIELD_TOP-j, (cells >> i) & 1);
+      _shown[j] = cells;
+    }
     mp.update(true);
   }
 
   void clearField(void)
   // clear the playing field
   {
-    memset(_field, 0, sizeof(bool)*FIELD_HEIGHT*FIELD_WIDTH);
+    _field.clear();
+    for (uint8_t j = 0; j < FIELD_HEIGHT; j++)
+      _shown[j] = board_t::CELLS;   // so all the cells are displayed
     displayField();
   }
 
-  uint8_t rotate(uint8_t x, uint8_t y, uint8_t r)
-  // return the linear index for from the x, y coords and the 
-  // current rotation
-  {
-    uint8_t idx = 0;
-
-    switch (r)             // Rotation effect
-    {
-      case 0: // 0 degrees    // 0  1  2  3
-      idx = y * 4 + x;        // 4  5  6  7
-      break;                  // 8  9 10 11
-                              //12 13 14 15
-
-    case 1: // 90 degrees     //12  8  4  0
-      idx = 12 + y - (x * 4); //13  9  5  1
-      break;                  //14 10  6  2
-                              //15 11  7  3
-
-    case 2: // 180 degrees    //15 14 13 12
-      idx = 15 - (y * 4) - x; //11 10  9  8
-      break;                  // 7  6  5  4
-                              // 3  2  1  0
-
-    case 3: // 270 degrees    // 3  7 11 15
-      idx = 3 - y + (x * 4);  // 2  6 10 14
-      break;                  // 1  5  9 13
-    }                         // 0  4  8 12
-
-    return(idx);
-  }
-  
   bool checkPieceFit(uint8_t omino, uint8_t rot, int16_t x, int16_t y)
     // does the piece fit in the _field array?
   {
-    /*
-    PRINTXY("\n-- CHKFIT @", x, y);
-    PRINT(" T:", omino);
-    PRINT(" R:", rot);
-    PRINT(" H:", FIELD_HEIGHT);
-    PRINT(" W:", FIELD_WIDTH);
-    */
-    for (int8_t j = 0; j < OMINO_SIZE; j++)
-    {
-      for (int8_t i = 0; i < OMINO_SIZE; i++)
-      {
-        // Get index into piece
-        int8_t idx = rotate(i, j, rot);
-        bool bCell = (_tetromino[omino] >> idx) & 1;
-
-        if (bCell)  // we have an occupied cell in the tetromino
-        {
-          // PRINTXY("\n", i, j); PRINTXY("=>", x + i, y + j); PRINT(" i:", idx); PRINT(" cell: ", bCell);
-          // check it is in bounds
-          if (x + i < 0 || x + i >= FIELD_WIDTH)
-          {
-            //PRINTS(" fail x");
-            return(false);  // out of side bounds
-          }
-          else if (y + j < 0 || y + j >= FIELD_HEIGHT)
-          {
-            //PRINTS(" fail y");
-            return(false);  // out of bounds
-          }
-          else if (_field[x + i][y + j]) // in bounds - do a collision check
-          {
-            //PRINTS(" fail field");
-            return(false); // occupied field cell
-          }
-        }
-      }
-    }
-    //PRINTS(" pass");
-    return(true);
+    return(_field.fit(_piece, omino, rot, x, y));
   }
 
 public:
   enum moveType_t { M_LEFT, M_RIGHT, M_DROP, M_ROTATE };
 
-  cTetris(void)
-  {
-    // straight block
-    // 0010
-    // 0010
-    // 0010
-    // 0010
-    _tetromino[0] = 0x2222;
-
-    // T block
-    // 0010
-    // 0110
-    // 0010
-    // 0000
-    _tetromino[1] = 0x2620; 
-
-    // square block
-    // 0000
-    // 0110
-    // 0110
-    // 0000
-    _tetromino[2] = 0x0660;
-
-    // normal Z block
-    // 0010
-    // 0110
-    // 0100
-    // 0000
-    _tetromino[3] = 0x2640;
-
-    // reversed Z block 
-    // 0100
-    // 0110
-    // 0010
-    // 0000
-    _tetromino[4] = 0x4620;
-
-    // normal L block
-    // 0100
-    // 0100
-    // 0110
-    _tetromino[5] = 0x4460;
-
-    // reversed L block
-    // 0010
-    // 0010
-    // 0110
-    _tetromino[6] = 0x2260;
-  }
-
   uint16_t getDelay(void) { return (_moveDelay); }
   void setDelay(uint16_t delay) { if (delay > 10) _moveDelay = delay; }
 
+  uint32_t pieces(void) { return(_pieces); }    // number of pieces dealt, changes with each new piece
+  uint8_t curOmino(void) { return(_curOmino); }
+  uint8_t nxtOmino(void) { return(_nxtOmino); }
+  uint8_t rotation(void) { return(_curRotation); }
+  int16_t x(void) { return(_x); }
+  const board_t &field(void) { return(_field); }
+  const cTetromino &tetromino(void) { return(_piece); }
+
   void start(void) { _run = true; }
   void stop(void)  { _run = false; }
 
@@ -404,7 +300,7 @@ public:
 
     // set up the next tetronimo
     _curOmino = 0;
-    _nxtOmino = random(ARRAY_SIZE(_tetromino));
+    _nxtOmino = random(cTetromino::COUNT);
     _curRotation = 0;
 
     // save and reset the score
@@ -424,6 +320,7 @@ public:
     _y = 0;
     _curRotation = 0;
     _curOmino = _nxtOmino;
+    _pieces++;
     if (!checkPieceFit(_curOmino, _curRotation, _x, _y))
       return(false);    // can't fit it it, pass the message back!
     drawOmino(_curOmino, _curRotation, _x, _y);
@@ -431,7 +328,7 @@ public:
 
     // work out and display the next omino
     eraseNxtOmino();
-    _nxtOmino = random(ARRAY_SIZE(_tetromino));
+    _nxtOmino = random(cTetromino::COUNT);
     drawNxtOmino();
     return(true);
   }
@@ -502,7 +399,7 @@ public:
       _pieceCount++; // just landed another one
 
       // insert the current piece in the field, show it and update the score
-      omino2Field(_curOmino, _curRotation, _x, _y);
+      _field.place(_piece, _curOmino, _curRotation, _x, _y);
       displayField();
       _pScore->increment(PIECE_SCORE);
 
@@ -511,29 +408,24 @@ public:
       // check the 4 lines it takes up
       uint16_t lines = 0;
 
-      for (int16_t y = _y + OMINO_SIZE; (y >= _y) && (y >= 0); y--)
-      {
-        int16_t count = 0;
-
-        for (int16_t x = 0; x < FIELD_WIDTH; x++)
-          count += (_field[x][y] ? 1 : 0);
+      int16_t y = _y + OMINO_SIZE - 1;
 
-        if (count == FIELD_WIDTH)
+      if (y >= FIELD_HEIGHT) y = FIELD_HEIGHT - 1;
+      for ( ; y >= _y; y--)
+      {
+        if (_field.full(y))
         {
           lines++;    // keep count of lines completed
 
           // delete the line - blank it out, pause for effect, 
           // make a sound then collapse the lines!
-          for (int16_t x = 0; x < FIELD_WIDTH; x++)
-            _field[x][y] = false;
+          _field.blank(y);
 
           displayField();
           delay(200);
           _pSound->bounce();
 
-          for (int16_t j = y; j >= 1; j--)
-            for (int16_t x = 0; x < FIELD_WIDTH; x++)
-              _field[x][j] = _field[x][j-1];
+          _field.collapse(y);
           displayField();
 
           // roll back the index as we have just changed the lines
@@ -557,6 +449,7 @@ cScore score;
 cMoveSW moveSW;
 cSound sound;
 cTetris tetris;
+cTetrisAI<FIELD_WIDTH, FIELD_HEIGHT> ai(tetris.tetromino());
 
 void setupField(void)
 // Draw the playing field at the start of the game.
@@ -605,9 +498,40 @@ bool handleUI(void)
   return(b);
 }
 
+void handleDemo(void)
+// move the piece towards the place chosen by the auto-player
+{
+  static uint32_t piece = 0;    // the piece the move is for
+  static uint32_t timeLastMove = 0;
+  static cTetrisAI<FIELD_WIDTH, FIELD_HEIGHT>::move_t m;
+  static bool planned = false;
+
+  if (tetris.pieces() != piece)
+  {
+    piece = tetris.pieces();
+    planned = ai.plan(tetris.field(), tetris.curOmino(), tetris.nxtOmino(), tetris.x(), m);
+    PRINT("\n-- DEMO move R:", m.rot); PRINT(" X:", m.x);
+  }
+
+  if (!planned || millis() - timeLastMove < DEMO_MOVE_TIME)
+    return;
+  timeLastMove = millis();
+
+  // rotate first, then slide across and drop
+  if (tetris.rotation() != m.rot)
+    tetris.move(cTetris::M_ROTATE);
+  else if (tetris.x() > m.x)
+    tetris.move(cTetris::M_LEFT);
+  else if (tetris.x() < m.x)
+    tetris.move(cTetris::M_RIGHT);
+  else
+    tetris.move(cTetris::M_DROP);
+}
+
 void loop(void)
 {
-  static enum { S_SPLASH, S_INIT, S_WAIT_START, S_PLAY, S_GAME_OVER } runState = S_SPLASH;
+  static enum { S_SPLASH, S_INIT, S_WAIT_START, S_PLAY, S_DEMO, S_GAME_OVER } runState = S_SPLASH;
+  static uint32_t timeStart;    // time waiting for the start of a game
 
   switch (runState)
   {
@@ -634,6 +558,7 @@ void loop(void)
     PRINTSTATE("INIT");
     setupField();
     tetris.begin(&score, &sound);
+    timeStart = millis();
 
     runState = S_WAIT_START;
     PRINTSTATE("WAIT_START");
@@ -653,6 +578,19 @@ void loop(void)
       else
         runState = S_GAME_OVER;
     }
+    else if (millis() - timeStart >= DEMO_DELAY)
+    {
+      PRINTS("\n-- Starting Demo");
+      ai.setLookahead(DEMO_LOOKAHEAD);
+      tetris.start();
+      if (tetris.nextOmino())
+      {
+        runState = S_DEMO;
+        PRINTSTATE("DEMO");
+      }
+      else
+        runState = S_GAME_OVER;
+    }
     break;
 
   case S_PLAY:    // playing a point
@@ -667,6 +605,23 @@ void loop(void)
     }
     break;
 
+  case S_DEMO:    // playing itself until a switch is pressed
+    if (moveSW.anyKey())
+    {
+      tetris.stop();
+      runState = S_INIT;
+      break;
+    }
+
+    handleDemo();
+
+    if (!tetris.run())
+    {
+      tetris.stop();
+      runState = S_GAME_OVER;
+    }
+    break;
+
   case S_GAME_OVER:
   {
     uint16_t w, x, y;
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "tetrisBoard.h"
+
+// A class to choose where to drop each Tetris piece.
+//
+// Every rotation of the current piece is tried at every column it can reach
+// from where it enters the well, then dropped. With lookahead set, every
+// placement of the next piece is also tried in each of the wells that
+// result, so the current piece is placed where the best pair of moves
+// starts. Each well is scored from the lines cleared, the sum of the column
+// heights, the holes with a block above them and the bumpiness (the sum of
+// the height changes from column to column), using the weights found by
+// Yiyuan Lee's genetic search, scaled to integers.
+//
+// The placements searched are those the game can reach by rotating the
+// piece at the top of the well, sliding it sideways and dropping it, which
+// is how the sketch moves the piece in the demo.
+template <uint8_t W, uint8_t H>
+class cTetrisAI
+{
+public:
+  typedef cTetrisBoard<W, H> board_t;
+
+  struct move_t
+  {
+    uint8_t rot;    // rotation of the piece
+    int8_t x;       // column of the piece
+  };
+
+  cTetrisAI(const cTetromino &t) : _t(t) {}
+
+  void setLookahead(bool b) { _lookahead = b; }
+  uint32_t evaluated(void) { return(_evaluated); }   // placements tried since resetCount()
+  void resetCount(void) { _evaluated = 0; }
+
+  bool plan(const board_t &b, uint8_t cur, uint8_t nxt, int8_t x, move_t &m)
+  // Choose the move for piece cur entering the well at column x, with piece
+  // nxt to follow. Return false if the piece does not fit anywhere.
+  {
+    return(search(b, cur, nxt, x, 0, _lookahead ? 2 : 1, &m) != NO_MOVE);
+  }
+
+private:
+  static const int32_t NO_MOVE = -2147483647L - 1;   // score when the piece does not fit
+  static const int32_t LOST = NO_MOVE + 1;           // score when the next piece does not fit
+
+  static const int16_t W_LINES = 761;     // weights of the score parts, x1000
+  static const int16_t W_HEIGHT = -510;
+  static const int16_t W_HOLES = -357;
+  static const int16_t W_BUMPY = -184;
+
+  const cTetromino &_t;       // the pieces
+  bool _lookahead = true;     // also place the next piece
+  uint32_t _evaluated = 0;    // placements tried
+
+  int32_t search(const board_t &b, uint8_t omino, uint8_t nxt, int8_t x0, uint8_t lines, uint8_t depth, move_t *m)
+  // return the best score for placing omino in b, with the next piece too
+  // if depth is 2, and set m to the move with that score
+  {
+    int32_t best = NO_MOVE;
+
+    for (uint8_t rot = 0; rot < cTetromino::MAX_ROTATE; rot++)
+    {
+      // the rotations are done in order at the top of the well
+      if (!b.fit(_t, omino, rot, x0, 0))
+        break;
+
+      // slide as far left as the piece goes, then try each column to the right
+      int8_t x = x0;
+
+      while (b.fit(_t, omino, rot, x - 1, 0))
+        x--;
+
+      for ( ; b.fit(_t, omino, rot, x, 0); x++)
+      {
+        board_t next = b;
+        int8_t y = next.drop(_t, omino, rot, x, 0);
+        int32_t s;
+
+        next.place(_t, omino, rot, x, y);
+        uint8_t n = lines + next.clearLines(y);
+
+        _evaluated++;
+        if (depth > 1)
+        {
+          s = search(next, nxt, nxt, x0, n, depth - 1, nullptr);
+          if (s == NO_MOVE) s = LOST;
+        }
+        else
+          s = score(next, n);
+
+        if (s > best)
+        {
+          best = s;
+          if (m != nullptr)
+          {
+            m->rot = rot;
+            m->x = x;
+          }
+        }
+      }
+    }
+
+    return(best);
+  }
+
+  int32_t score(const board_t &b, uint8_t lines)
+  // score the well after lines have been cleared
+  {
+    uint8_t height[W];
+    uint16_t covered = 0;   // columns with a block in or above the row
+    uint16_t holes = 0, total = 0, bumpy = 0;
+
+    memset(height, 0, sizeof(height));
+    for (uint8_t y = 0; y < H; y++)
+    {
+      uint16_t row = b.cells(y);
+      uint16_t top = row & ~covered;    // highest block in the column
+
+      for (uint8_t x = 0; top != 0; x++, top >>= 1)
+        if (top & 1) height[x] = H - y;
+
+      holes += __builtin_popcount(covered & ~row);
+      covered |= row;
+    }
+
+    for (uint8_t x = 0; x < W; x++)
+    {
+      total += height[x];
+      if (x > 0)
+        bumpy += (height[x] > height[x - 1]) ? height[x] - height[x - 1] : height[x - 1] - height[x];
+    }
+
+    return(((int32_t)W_LINES * lines) + ((int32_t)W_HEIGHT * total) + ((int32_t)W_HOLES * holes) + ((int32_t)W_BUMPY * bumpy));
+  }
+};
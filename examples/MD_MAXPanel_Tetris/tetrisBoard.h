@@ -0,0 +1,211 @@
+#pragma once
+
+// A class to encapsulate the tetrominoes.
+// Each tetromino is held for every rotation as a mask of 4 rows of 4 bits,
+// with row j in bits 4j to 4j+3 and column i in bit i of the row. The masks
+// are worked out once in the constructor.
+class cTetromino
+{
+public:
+  static const uint8_t SIZE = 4;        // 4x4 field flattened out into 16 bits
+  static const uint8_t COUNT = 7;       // number of different tetrominoes
+  static const uint8_t MAX_ROTATE = 4;  // maximum number of rotations
+
+  cTetromino(void)
+  {
+    uint16_t tetromino[COUNT];
+
+    // straight block
+    // 0010
+    // 0010
+    // 0010
+    // 0010
+    tetromino[0] = 0x2222;
+
+    // T block
+    // 0010
+    // 0110
+    // 0010
+    // 0000
+    tetromino[1] = 0x2620;
+
+    // square block
+    // 0000
+    // 0110
+    // 0110
+    // 0000
+    tetromino[2] = 0x0660;
+
+    // normal Z block
+    // 0010
+    // 0110
+    // 0100
+    // 0000
+    tetromino[3] = 0x2640;
+
+    // reversed Z block
+    // 0100
+    // 0110
+    // 0010
+    // 0000
+    tetromino[4] = 0x4620;
+
+    // normal L block
+    // 0100
+    // 0100
+    // 0110
+    tetromino[5] = 0x4460;
+
+    // reversed L block
+    // 0010
+    // 0010
+    // 0110
+    tetromino[6] = 0x2260;
+
+    // pre-rotate the tetronimoes into rows
+    for (uint8_t n = 0; n < COUNT; n++)
+      for (uint8_t r = 0; r < MAX_ROTATE; r++)
+      {
+        _omino[n][r] = 0;
+        for (uint8_t j = 0; j < SIZE; j++)
+          for (uint8_t i = 0; i < SIZE; i++)
+            if ((tetromino[n] >> rotate(i, j, r)) & 1)
+              _omino[n][r] |= (1 << (j * SIZE + i));
+      }
+  }
+
+  uint8_t row(uint8_t omino, uint8_t rot, uint8_t j) const
+  // return row j of the rotated tetronimo, with column i in bit i
+  {
+    return((_omino[omino][rot] >> (j * SIZE)) & 0xf);
+  }
+
+private:
+  uint16_t _omino[COUNT][MAX_ROTATE];   // rotated tetrominoes
+
+  static uint8_t rotate(uint8_t x, uint8_t y, uint8_t r)
+  // return the linear index for from the x, y coords and the
+  // current rotation
+  {
+    uint8_t idx = 0;
+
+    switch (r)             // Rotation effect
+    {
+      case 0: // 0 degrees    // 0  1  2  3
+      idx = y * 4 + x;        // 4  5  6  7
+      break;                  // 8  9 10 11
+                              //12 13 14 15
+
+    case 1: // 90 degrees     //12  8  4  0
+      idx = 12 + y - (x * 4); //13  9  5  1
+      break;                  //14 10  6  2
+                              //15 11  7  3
+
+    case 2: // 180 degrees    //15 14 13 12
+      idx = 15 - (y * 4) - x; //11 10  9  8
+      break;                  // 7  6  5  4
+                              // 3  2  1  0
+
+    case 3: // 270 degrees    // 3  7 11 15
+      idx = 3 - y + (x * 4);  // 2  6 10 14
+      break;                  // 1  5  9 13
+    }                         // 0  4  8 12
+
+    return(idx);
+  }
+};
+
+// A class to encapsulate the Tetris well.
+// The well is W cells wide and H cells deep, held as a 16 bit word for each
+// row with row 0 at the top and cell x in bit (x + WALL). The bits outside
+// the well are set as the walls and the rows below the well are set as the
+// floor, so a piece fits if none of its rows overlap the well rows. Every
+// piece has a block in one of its 3 left columns, so a piece is never tried
+// at an x less than -WALL.
+template <uint8_t W, uint8_t H>
+class cTetrisBoard
+{
+public:
+  static const uint8_t WALL = 3;        // wall bits on the left of each row
+  static const uint16_t FULL_ROW = 0xffff;
+  static const uint16_t EMPTY_ROW = (uint16_t)~(((1 << W) - 1) << WALL);  // only the walls set
+  static const uint16_t CELLS = (1 << W) - 1;   // cells of a row returned by cells()
+
+  static_assert(W + (2 * WALL) <= 16, "Well is too wide for the row bits");
+
+  void clear(void)
+  // clear the well and set the floor below it
+  {
+    for (uint8_t j = 0; j < H; j++)
+      _row[j] = EMPTY_ROW;
+    for (uint8_t j = H; j < H + cTetromino::SIZE; j++)
+      _row[j] = FULL_ROW;
+  }
+
+  uint16_t cells(uint8_t y) const { return((_row[y] >> WALL) & CELLS); }  // cell x of row y in bit x
+  bool full(uint8_t y) const { return(_row[y] == FULL_ROW); }
+  void blank(uint8_t y) { _row[y] = EMPTY_ROW; }
+
+  bool fit(const cTetromino &t, uint8_t omino, uint8_t rot, int8_t x, int8_t y) const
+  // does the piece fit in the well?
+  {
+    for (uint8_t j = 0; j < cTetromino::SIZE; j++)
+    {
+      uint8_t row = t.row(omino, rot, j);
+
+      if (row != 0 && (((uint16_t)row << (x + WALL)) & _row[y + j]) != 0)
+        return(false); // occupied well, wall or floor cell
+    }
+    return(true);
+  }
+
+  int8_t drop(const cTetromino &t, uint8_t omino, uint8_t rot, int8_t x, int8_t y) const
+  // return the row the piece comes to rest on when dropped from y
+  {
+    while (fit(t, omino, rot, x, y + 1))
+      y++;
+    return(y);
+  }
+
+  void place(const cTetromino &t, uint8_t omino, uint8_t rot, int8_t x, int8_t y)
+  // copy the piece to the well, leaving the rest untouched
+  {
+    for (uint8_t j = 0; j < cTetromino::SIZE; j++)
+    {
+      uint8_t row = t.row(omino, rot, j);
+
+      if (row != 0)
+        _row[y + j] |= (uint16_t)row << (x + WALL);
+    }
+  }
+
+  void collapse(uint8_t y)
+  // remove row y, moving the rows above it down
+  {
+    memmove(&_row[1], &_row[0], y * sizeof(_row[0]));
+    _row[0] = EMPTY_ROW;
+  }
+
+  uint8_t clearLines(int8_t y)
+  // remove the full lines of a piece placed at y, return the number removed
+  {
+    uint8_t lines = 0;
+    int8_t j = y + cTetromino::SIZE - 1;
+
+    if (j >= H) j = H - 1;
+    for ( ; j >= y; j--)
+    {
+      if (full(j))
+      {
+        collapse(j);
+        lines++;
+        j++;    // check the line that moved down into j
+      }
+    }
+
+    return(lines);
+  }
+
+private:
+  uint16_t _row[H + cTetromino::SIZE];  // well rows, with the floor below
+};
@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""
+FontPack - convert MD_MAX72xx fonts to the MD_MAXPanel packed font format.
+
+Usage: fontpack.py [-n name] font.h[:offset] [font.h[:offset] ...]
+
+Each input is a C/C++ source file with an MD_MAX72xx font table, such as the
+Font5x3.h files in the library examples. Both the version 1 format (starting
+with 'F', 1, first, last, height) and the original 256 character format are
+read. The character codes of a font are moved up by offset, if given, so that
+several 8 bit fonts can be combined into one font with 16 bit (Unicode)
+character codes; characters with columns in later fonts replace those in
+earlier ones, while their empty characters are ignored. For example, Greek
+letters drawn as codes 0x10 to 0x28 in a second font can be placed at their
+Unicode codes with greek.h:0x381.
+
+Fonts must be 1 to 8 pixels high, as each character column is one byte.
+
+The packed font is written to standard output as a PROGMEM table named name
+(default is the first input table name with _Packed added), to be used with
+MD_MAXPanel::setPackedFont(). Characters with no columns are left out, and
+the remaining character codes are stored as a table of ranges.
+
+Each character column is stored as a code of as few bits as possible. This is
+either the column value itself, using the font height in bits, or an index
+into a dictionary of the different column values in the font, whichever makes
+the smaller table. The dictionary has an entry for every code, so it is padded
+to a power of 2 entries. See setPackedFont() in MD_MAXPanel.h for the format.
+"""
+import argparse
+import re
+import sys
+
+PACKED_FONT_SIG = ord('P')
+PACKED_FONT_VER = 1
+PACKED_FONT_BLOCK = 8
+RANGE_GAP_MAX = 5       # missing codes kept in a range rather than starting a new one
+
+
+def read_font(text):
+    """Return (table name, first, last, height, list of glyph column lists)."""
+    text = re.sub(r'//[^\n]*', '', text)
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    m = re.search(r'(\w+)\s*\[\s*\]\s*(?:PROGMEM\s*)?=\s*\{(.*?)\}', text, re.S)
+    if m is None:
+        sys.exit('fontpack: no font table found')
+
+    values = []
+    for tok in m.group(2).replace('\n', ' ').split(','):
+        tok = tok.strip()
+        if not tok:
+            continue
+        if re.fullmatch(r"'.'", tok):
+            values.append(ord(tok[1]))
+        else:
+            values.append(int(tok, 0))
+
+    if values[0] == ord('F') and values[1] == 1:
+        first, last, height = values[2], values[3], values[4]
+        pos = 5
+    else:
+        first, last, height = 0, 255, 8
+        pos = 0
+
+    glyphs = []
+    for _ in range(first, last + 1):
+        width = values[pos]
+        glyphs.append(values[pos + 1:pos + 1 + width])
+        pos += width + 1
+
+    return m.group(1), first, last, height, glyphs
+
+
+def make_ranges(chars):
+    """Return the (first, last) code ranges covering chars, a dict of code to glyph.
+
+    Short gaps between characters are filled with empty characters, as each
+    empty character takes less space than a new range entry.
+    """
+    codes = sorted(c for c, g in chars.items() if g)
+    ranges = []
+    for c in codes:
+        if ranges and c - ranges[-1][1] <= RANGE_GAP_MAX + 1:
+            ranges[-1][1] = c
+        else:
+            ranges.append([c, c])
+    return ranges
+
+
+def pack_font(height, chars):
+    """Return the packed font as a list of bytes and a description of the coding."""
+    ranges = make_ranges(chars)
+    if len(ranges) > 255:
+        sys.exit('fontpack: too many character ranges')
+    glyphs = [chars.get(c, []) for first, last in ranges for c in range(first, last + 1)]
+    columns = [c for g in glyphs for c in g]
+    dictionary = sorted(set(columns))
+
+    # code the columns directly or through the dictionary, whichever is smaller;
+    # the dictionary is padded to an entry for every code
+    dict_bits = max(1, (len(dictionary) - 1).bit_length())
+    direct_size = (len(columns) * height + 7) // 8
+    dict_size = (1 << dict_bits) + (len(columns) * dict_bits + 7) // 8
+    if dict_bits < height and dict_size < direct_size:
+        bits, codes = dict_bits, [dictionary.index(c) for c in columns]
+        dictionary += [0] * ((1 << dict_bits) - len(dictionary))
+    else:
+        bits, codes, dictionary = height, columns, []
+
+    out = [PACKED_FONT_SIG, PACKED_FONT_VER, height,
+           max([len(g) for g in glyphs] + [0]), bits, len(dictionary), len(ranges), 0]
+    out += dictionary
+
+    # ranges: first and last code and index of the first character
+    base = 0
+    for first, last in ranges:
+        for v in (first, last, base):
+            out += [v & 0xff, v >> 8]
+        base += last - first + 1
+
+    # index: block column offsets then the character widths
+    offset = 0
+    for i, g in enumerate(glyphs):
+        if offset > 0xffff:
+            sys.exit('fontpack: too many character columns for 16 bit offsets')
+        if i % PACKED_FONT_BLOCK == 0:
+            out += [offset & 0xff, offset >> 8]
+        offset += len(g)
+    out += [len(g) for g in glyphs]
+
+    # data: bit packed column codes, MSB first
+    acc, n = 0, 0
+    for c in codes:
+        acc = (acc << bits) | c
+        n += bits
+        while n >= 8:
+            n -= 8
+            out.append((acc >> n) & 0xff)
+    if n:
+        out.append((acc << (8 - n)) & 0xff)
+
+    if len(dictionary):
+        coding = '%d bit dictionary codes, %d entries' % (bits, len(dictionary))
+    else:
+        coding = '%d bit columns' % bits
+    coding += ', %d range%s' % (len(ranges), '' if len(ranges) == 1 else 's')
+    return out, coding
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert MD_MAX72xx fonts to MD_MAXPanel packed fonts.')
+    parser.add_argument('-n', '--name', help='name of the packed font table')
+    parser.add_argument('fonts', nargs='+', metavar='font.h[:offset]', help='MD_MAX72xx font files')
+    args = parser.parse_args()
+
+    chars = {}
+    height = 0
+    original = 0
+    name = None
+    for spec in args.fonts:
+        path, _, offset = spec.partition(':')
+        offset = int(offset, 0) if offset else 0
+        with open(path) as f:
+            table, first, last, h, glyphs = read_font(f.read())
+        if name is None:
+            name = table + '_Packed'
+        if h < 1 or h > 8:
+            sys.exit('fontpack: font height %d in %s is not 1 to 8' % (h, path))
+        height = max(height, h)
+        original += 5 + sum(len(g) + 1 for g in glyphs)
+        for c, g in zip(range(first, last + 1), glyphs):
+            if not g:
+                continue
+            if c + offset > 0xffff:
+                sys.exit('fontpack: character code beyond 16 bits in %s' % path)
+            chars[c + offset] = g
+    if args.name:
+        name = args.name
+
+    packed, coding = pack_font(height, chars)
+
+    print('#pragma once')
+    print()
+    print('// Packed font generated by FontPack from %s' % ' '.join(args.fonts))
+    print('// %d bytes (MD_MAX72xx font %d bytes), %s' % (len(packed), original, coding))
+    print('const uint8_t %s[] PROGMEM =' % name)
+    print('{')
+    for i in range(0, len(packed), 16):
+        print('  ' + ', '.join('0x%02x' % b for b in packed[i:i + 16]) + ',')
+    print('};')
+
+
+if __name__ == '__main__':
+    main()
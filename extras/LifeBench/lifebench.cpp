@@ -0,0 +1,397 @@
+/*
+LifeBench - multi-threaded Game of Life engine and benchmark for the host.
+
+Build: g++ -O2 -std=c++11 -pthread lifebench.cpp -o lifebench
+Usage: lifebench [threads [rule]]
+
+The cLifeBands class below works out the generations of a packed bit Life
+universe like cLife in the MD_MAXPanel_GameOfLife example, using the same
+cLifeRule kernel, but the size of the universe is set when it is created and
+the rows are shared out between a pool of threads. This is meant for running
+rules on the host and working out demo sequences before they are sent to the
+panels.
+
+The universe is split into bands of rows, several for each thread. At the
+start of each generation every thread is given an equal run of bands. A
+thread that finishes its own bands takes bands from the runs of the other
+threads, so a slow thread does not hold up the generation. Each band reads
+the halo rows next to it, the last row of the band below and the first row of
+the band above, from the last generation, which is not changed until all the
+bands are done, so the halo rows are exchanged by the wait at the end of each
+generation.
+
+The benchmark first checks cLifeBands against cLife for each number of
+threads, then reports the cell updates per second for square universes from
+64x64 to 8192x8192 as the number of threads goes up to the limit given
+(default is the number of cores).
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../../examples/MD_MAXPanel_GameOfLife/life.h"
+
+// A class to encapsulate a Game of Life universe worked out by a pool of
+// threads. Cell x of a row is in bit (x % BITS) of word (x / BITS).
+class cLifeBands
+{
+public:
+  typedef uint64_t word_t;
+  static const uint8_t BITS = 8 * sizeof(word_t);   // cells in each word
+
+  enum edge_t { BOUNDED, TOROIDAL };
+
+  cLifeBands(uint32_t w, uint32_t h, uint8_t threads) : _w(w), _h(h), _threads(threads)
+  {
+    _words = (_w + BITS - 1) / BITS;
+    _lastMask = (_w % BITS == 0) ? ~(word_t)0 : (((word_t)1 << (_w % BITS)) - 1);
+    _lastBit = (_w - 1) % BITS;
+    _cell[0].resize((size_t)_h * _words);
+    _cell[1].resize((size_t)_h * _words);
+    _zero.resize(_words);
+
+    // about 8 bands for each thread, so there is work to take
+    _bandRows = (_h + (8 * _threads) - 1) / (8 * _threads);
+    if (_bandRows < 4) _bandRows = 4;
+    _bands = (_h + _bandRows - 1) / _bandRows;
+
+    _worker = new worker_t[_threads];
+    for (uint8_t k = 1; k < _threads; k++)
+      _worker[k].thread = std::thread(&cLifeBands::workerLoop, this, k);
+
+    clear();
+  }
+
+  ~cLifeBands(void)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _quit = true;
+    }
+    _start.notify_all();
+    for (uint8_t k = 1; k < _threads; k++)
+      _worker[k].thread.join();
+    delete[] _worker;
+  }
+
+  bool setRule(const char *rule) { return(_rule.set(rule)); }
+  void setEdge(edge_t e) { _edge = e; }
+
+  void clear(void)
+  // kill all the cells
+  {
+    memset(_cell[_cur].data(), 0, _cell[_cur].size() * sizeof(word_t));
+    _population = 0;
+    _generation = 0;
+  }
+
+  bool getCell(uint32_t x, uint32_t y)
+  {
+    if (x >= _w || y >= _h) return(false);
+    return((row(_cur, y)[x / BITS] >> (x % BITS)) & 1);
+  }
+
+  void setCell(uint32_t x, uint32_t y, bool b)
+  {
+    if (x >= _w || y >= _h) return;
+
+    word_t *p = &row(_cur, y)[x / BITS];
+    word_t bit = (word_t)1 << (x % BITS);
+
+    if (((*p & bit) != 0) != b)
+    {
+      if (b) { *p |= bit; _population++; }
+      else   { *p &= ~bit; _population--; }
+    }
+  }
+
+  uint64_t population(void) { return(_population); }   // number of live cells
+  uint32_t generation(void) { return(_generation); }    // generations since clear()
+  uint32_t bands(void) { return(_bands); }              // number of bands of rows
+
+  void nextGeneration(void)
+  // work out the next generation from the current one using all the threads
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+
+      for (uint8_t k = 0; k < _threads; k++)
+      {
+        _worker[k].next = (uint32_t)(((uint64_t)_bands * k) / _threads);
+        _worker[k].end = (uint32_t)(((uint64_t)_bands * (k + 1)) / _threads);
+      }
+      _count = 0;
+      _running = _threads - 1;
+      _ticket++;
+    }
+    _start.notify_all();
+
+    work(0);    // this thread is worker 0
+
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _done.wait(lock, [this] { return(_running == 0); });
+    }
+
+    _population = _count;
+    _cur ^= 1;
+    _generation++;
+  }
+
+private:
+  struct worker_t
+  {
+    std::atomic<uint32_t> next;   // next band in the run of this thread
+    uint32_t end;                 // band after the end of the run
+    std::thread thread;           // the thread, not used for worker 0
+  };
+
+  uint32_t _w, _h;            // size of the universe in cells
+  uint32_t _words;            // words in each row
+  word_t _lastMask;           // cells used in the last word of a row
+  uint8_t _lastBit;           // bit of the last cell in the last word
+  std::vector<word_t> _cell[2];   // current and last universe
+  std::vector<word_t> _zero;  // dead row beyond bounded edges
+  uint8_t _cur = 0;           // index of the current universe
+  uint64_t _population = 0;   // number of live cells
+  uint32_t _generation = 0;   // number of generations since clear()
+  cLifeRule<word_t> _rule;    // rule for the next generation
+  edge_t _edge = BOUNDED;     // edge mode
+
+  uint8_t _threads;           // threads in the pool, including the caller
+  uint32_t _bandRows;         // rows in each band
+  uint32_t _bands;            // bands in the universe
+  worker_t *_worker;          // the state of each thread
+  std::atomic<uint64_t> _count;   // live cells counted in the next generation
+  std::mutex _mutex;          // guards the members below
+  std::condition_variable _start, _done;
+  uint32_t _ticket = 0;       // changed to start each generation
+  uint8_t _running = 0;       // threads still working on the generation
+  bool _quit = false;         // set to end the threads
+
+  word_t *row(uint8_t u, uint32_t y) { return(&_cell[u][(size_t)y * _words]); }
+
+  void workerLoop(uint8_t k)
+  // wait for each generation and do a share of the bands
+  {
+    uint32_t seen = 0;
+
+    for (;;)
+    {
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _start.wait(lock, [&] { return(_quit || _ticket != seen); });
+        if (_quit) return;
+        seen = _ticket;
+      }
+
+      work(k);
+
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (--_running == 0) _done.notify_one();
+      }
+    }
+  }
+
+  void work(uint8_t k)
+  // do the bands of thread k, then take bands from the other threads
+  {
+    for (uint8_t n = 0; n < _threads; n++)
+    {
+      worker_t &w = _worker[(k + n) % _threads];
+      uint32_t b;
+
+      while ((b = w.next.fetch_add(1)) < w.end)
+        nextBand(b);
+    }
+  }
+
+  void nextBand(uint32_t b)
+  // work out the next generation of the rows in band b
+  {
+    uint32_t y0 = b * _bandRows;
+    uint32_t y1 = (y0 + _bandRows < _h) ? y0 + _bandRows : _h;
+    const word_t *edgeRow[2];
+    uint64_t count = 0;
+
+    // rows beyond the bottom and top edges
+    if (_edge == TOROIDAL)
+    {
+      edgeRow[0] = row(_cur, _h - 1);
+      edgeRow[1] = row(_cur, 0);
+    }
+    else
+      edgeRow[0] = edgeRow[1] = _zero.data();
+
+    for (uint32_t y = y0; y < y1; y++)
+    {
+      const word_t *above = (y < _h - 1) ? row(_cur, y + 1) : edgeRow[1];
+      const word_t *below = (y > 0) ? row(_cur, y - 1) : edgeRow[0];
+      word_t *out = row(_cur ^ 1, y);
+
+      nextRow(out, above, row(_cur, y), below);
+      for (uint32_t i = 0; i < _words; i++)
+        count += lifePopCount(out[i]);
+    }
+
+    _count += count;
+  }
+
+  void nextRow(word_t *out, const word_t *above, const word_t *r, const word_t *below)
+  // work out the next generation of a row from the rows above and below
+  {
+    for (uint32_t i = 0; i < _words; i++)
+      out[i] = _rule.next(west(above, i), above[i], east(above, i),
+                          west(r, i), r[i], east(r, i),
+                          west(below, i), below[i], east(below, i));
+    out[_words - 1] &= _lastMask;
+  }
+
+  word_t west(const word_t *r, uint32_t i)
+  // cells shifted one place east, so each bit holds its west neighbour
+  {
+    word_t carry = 0;
+
+    if (i > 0)
+      carry = r[i - 1] >> (BITS - 1);
+    else if (_edge == TOROIDAL)
+      carry = (r[_words - 1] >> _lastBit) & 1;
+
+    return((r[i] << 1) | carry);
+  }
+
+  word_t east(const word_t *r, uint32_t i)
+  // cells shifted one place west, so each bit holds its east neighbour
+  {
+    word_t carry = 0;
+
+    if (i < _words - 1)
+      carry = r[i + 1] << (BITS - 1);
+    else if (_edge == TOROIDAL)
+      carry = (r[0] & 1) << _lastBit;
+
+    return((r[i] >> 1) | carry);
+  }
+};
+
+static uint32_t randomState = 1;
+
+static uint32_t randomNext(void)
+// xorshift32, so every run starts from the same soup
+{
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return(randomState);
+}
+
+template <uint16_t W, uint16_t H>
+static bool check(uint8_t threads, const char *rule, cLifeBands::edge_t edge)
+// compare cLifeBands with cLife for a few hundred generations
+{
+  static cLife<W, H, uint64_t> ref;
+  cLifeBands life(W, H, threads);
+
+  ref.clear();
+  ref.setRule(rule);
+  ref.setEdge(edge == cLifeBands::TOROIDAL ? cLife<W, H, uint64_t>::TOROIDAL : cLife<W, H, uint64_t>::BOUNDED);
+  life.setRule(rule);
+  life.setEdge(edge);
+
+  randomState = 1;
+  for (uint16_t y = 0; y < H; y++)
+    for (uint16_t x = 0; x < W; x++)
+    {
+      bool b = (randomNext() & 3) == 0;
+
+      ref.setCell(x, y, b);
+      life.setCell(x, y, b);
+    }
+
+  for (uint16_t g = 0; g < 300; g++)
+  {
+    ref.nextGeneration();
+    life.nextGeneration();
+    if (ref.population() != life.population())
+      return(false);
+    for (uint16_t y = 0; y < H; y++)
+      for (uint16_t x = 0; x < W; x++)
+        if (ref.getCell(x, y) != life.getCell(x, y))
+          return(false);
+  }
+
+  return(true);
+}
+
+int main(int argc, char *argv[])
+{
+  const uint64_t UPDATES = 1ULL << 28;    // cell updates timed for each run
+  uint8_t maxThreads = std::thread::hardware_concurrency();
+  const char *rule = (argc > 2) ? argv[2] : "B3/S23";
+
+  if (argc > 1) maxThreads = atoi(argv[1]);
+  if (maxThreads == 0) maxThreads = 1;
+
+  {
+    cLifeRule<uint64_t> r;
+
+    if (!r.set(rule))
+    {
+      fprintf(stderr, "Invalid rule %s\n", rule);
+      return(1);
+    }
+  }
+
+  // check that the bands give the same generations as cLife
+  for (uint8_t t = 1; t <= maxThreads; t++)
+  {
+    if (!check<64, 64>(t, rule, cLifeBands::TOROIDAL) ||
+        !check<100, 70>(t, rule, cLifeBands::TOROIDAL) ||
+        !check<100, 70>(t, rule, cLifeBands::BOUNDED))
+    {
+      fprintf(stderr, "Check failed with %u threads\n", t);
+      return(1);
+    }
+  }
+  printf("Rule %s, checked against cLife for 1 to %u threads\n\n", rule, maxThreads);
+
+  printf("%11s %7s %7s %10s %14s %8s\n", "Size", "Threads", "Bands", "Gens", "Cell updates/s", "Speedup");
+  for (uint32_t size = 64; size <= 8192; size *= 2)
+  {
+    uint64_t cells = (uint64_t)size * size;
+    uint32_t gens = (UPDATES / cells < 4) ? 4 : (uint32_t)(UPDATES / cells);
+    double rate1 = 0;
+
+    for (uint8_t t = 1; ; t = (t * 2 < maxThreads) ? t * 2 : maxThreads)
+    {
+      cLifeBands life(size, size, t);
+
+      life.setRule(rule);
+      life.setEdge(cLifeBands::TOROIDAL);
+      randomState = 1;
+      for (uint32_t y = 0; y < size; y++)
+        for (uint32_t x = 0; x < size; x++)
+          life.setCell(x, y, (randomNext() & 3) == 0);
+
+      auto start = std::chrono::steady_clock::now();
+      for (uint32_t g = 0; g < gens; g++)
+        life.nextGeneration();
+      std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+
+      double rate = (cells * gens) / secs.count();
+
+      if (t == 1) rate1 = rate;
+      printf("%5ux%-5u %7u %7u %10u %14.3e %7.2fx\n", size, size, t, life.bands(), gens, rate, rate / rate1);
+      if (t == maxThreads) break;
+    }
+  }
+
+  return(0);
+}
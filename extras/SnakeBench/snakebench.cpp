@@ -0,0 +1,161 @@
+/*
+SnakeBench - play Snake with the autopilot at full speed on the host.
+
+Build: g++ -O2 -std=c++11 snakebench.cpp -o snakebench
+Usage: snakebench [games [width height]]
+
+The game is played with the cSnakeGrid occupancy grid and cSnakeAI autopilot
+of the MD_MAXPanel_Snake example, without a display, in a field the size of
+the sketch field (38x23) unless another size is given, with walls all round.
+The search queue is the same size as in the sketch. Each pill is worth 0 to
+9 cells of growth, as in the game, but the snake is not limited in length,
+so a game ends when the snake fills the field, has nowhere to go or runs
+into itself, or after a limit of moves.
+
+The benchmark reports how the games ended, the moves made per second and the
+longest time taken to choose a single move, which is the worst case frame
+cost of the autopilot on the host. As the longest time also catches the
+host being busy elsewhere, the most cells taken from the queue by a single
+search is shown too, along with the searches that filled the queue and fell
+back to the cycle.
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "../../examples/MD_MAXPanel_Snake/snakeAI.h"
+
+const uint16_t GRID_CELLS = 64 * 64;    // largest grid, with the walls
+const uint16_t SEARCH_QUEUE = 64;       // same as the sketch
+const uint8_t PILL_VALUE_MAX = 9;       // most growth from one pill
+const uint8_t SNAKE_SIZE_DEFAULT = 2;
+
+typedef cSnakeGrid<GRID_CELLS> grid_t;
+typedef cSnakeAI<GRID_CELLS, SEARCH_QUEUE> ai_t;
+
+static uint32_t randomState = 1;
+
+static uint32_t randomNumber(uint32_t n)
+// xorshift32, so every run plays the same games
+{
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return(randomState % n);
+}
+
+struct result_t
+{
+  uint32_t won;       // games where the snake filled the field
+  uint32_t trapped;   // games where the snake had nowhere to go
+  uint32_t crashed;   // games where the snake ran into itself
+  uint32_t limited;   // games stopped at the move limit
+  uint64_t moves;     // moves made
+  uint64_t length;    // sum of the final lengths
+  double maxMove;     // longest time to choose a move, in seconds
+  uint16_t maxSearch; // most cells searched for a move
+};
+
+static uint16_t body[GRID_CELLS];   // ring buffer of body segment cells
+
+static void play(grid_t &g, ai_t &ai, uint16_t width, uint16_t height, result_t &r)
+// play one game, adding the result to r
+{
+  const uint16_t fieldCells = width * height;
+  const uint32_t moveLimit = 1000UL * fieldCells;
+  uint16_t head = 0, length = 0, grow = 0;
+  uint16_t food;
+  uint32_t moves = 0;
+
+  // walls all round the field
+  g.fill(true);
+  for (uint16_t y = 1; y <= height; y++)
+    for (uint16_t x = 1; x <= width; x++)
+      g.set(g.cell(x, y), false);
+
+  // the snake starts in the middle heading right, as in the sketch
+  for (uint8_t i = SNAKE_SIZE_DEFAULT; i > 0; i--)
+  {
+    head = (head + 1) % GRID_CELLS;
+    body[head] = g.cell(((width + 1) / 2) - (i - 1), (height + 1) / 2);
+    g.set(body[head], true);
+    length++;
+  }
+  food = g.select(randomNumber(g.freeCells()));
+
+  for (;;)
+  {
+    uint16_t tail = body[(head + GRID_CELLS - (length - 1)) % GRID_CELLS];
+
+    auto start = std::chrono::steady_clock::now();
+    uint16_t c = ai.next(g, body[head], tail, food, grow + PILL_VALUE_MAX);
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+
+    if (secs.count() > r.maxMove) r.maxMove = secs.count();
+    if (ai.searched() > r.maxSearch) r.maxSearch = ai.searched();
+
+    if (c == ai_t::NO_CELL) { r.trapped++; break; }
+    if (g.get(c)) { r.crashed++; break; }
+    if (++moves > moveLimit) { r.limited++; break; }
+
+    // grow or move the tail up
+    if (grow != 0)
+      grow--;
+    else
+    {
+      g.set(tail, false);
+      length--;
+    }
+
+    head = (head + 1) % GRID_CELLS;
+    body[head] = c;
+    g.set(c, true);
+    length++;
+
+    if (c == food)
+    {
+      grow += randomNumber(PILL_VALUE_MAX + 1);
+      if (length + grow >= fieldCells) { r.won++; break; }
+      food = g.select(randomNumber(g.freeCells()));
+    }
+  }
+
+  r.moves += moves;
+  r.length += length;
+}
+
+int main(int argc, char *argv[])
+{
+  uint32_t games = (argc > 1) ? atol(argv[1]) : 10;
+  uint16_t width = (argc > 3) ? atoi(argv[2]) : 38;
+  uint16_t height = (argc > 3) ? atoi(argv[3]) : 23;
+  result_t r = { 0, 0, 0, 0, 0, 0, 0.0, 0 };
+  static grid_t g;
+  static ai_t ai;
+
+  if (!g.begin(width + 2, height + 2))
+  {
+    fprintf(stderr, "Field %ux%u is too big\n", width, height);
+    return(1);
+  }
+  if (!ai.begin(1, 1, width, height))
+  {
+    fprintf(stderr, "Field %ux%u has no cycle, one side must be even\n", width, height);
+    return(1);
+  }
+
+  printf("%u games in a %ux%u field\n\n", games, width, height);
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t n = 0; n < games; n++)
+    play(g, ai, width, height, r);
+  std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+
+  printf("%6s %8s %8s %8s %8s %10s %12s %12s %11s %10s\n", "Won", "Trapped", "Crashed", "Limited", "Length",
+    "Moves", "Moves/s", "Max us/move", "Max search", "Overflows");
+  printf("%6u %8u %8u %8u %8.1f %10llu %12.3e %12.1f %11u %10u\n", r.won, r.trapped, r.crashed, r.limited,
+    (double)r.length / games, (unsigned long long)r.moves, r.moves / secs.count(), r.maxMove * 1e6, r.maxSearch, ai.overflows());
+
+  return(0);
+}
@@ -0,0 +1,108 @@
+/*
+TetrisBench - play Tetris with the auto-player at full speed on the host.
+
+Build: g++ -O2 -std=c++11 tetrisbench.cpp -o tetrisbench
+Usage: tetrisbench [games [pieces]]
+
+The game is played with the cTetrisBoard well and cTetrisAI auto-player of
+the MD_MAXPanel_Tetris example, without a display, in the same 10x21 well.
+Each game ends when a piece does not fit or after the number of pieces
+given (default 1000), so a good player does not run forever. Every game is
+played twice, first placing only the current piece and then also looking
+ahead to the next piece, from the same random sequence of pieces.
+
+For each search the benchmark reports the pieces played, lines cleared and
+the placements tried per second, the rate at which the move generation,
+collision and scoring code runs.
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "../../examples/MD_MAXPanel_Tetris/tetrisAI.h"
+
+const uint8_t FIELD_WIDTH = 10;
+const uint8_t FIELD_HEIGHT = 21;
+
+typedef cTetrisBoard<FIELD_WIDTH, FIELD_HEIGHT> board_t;
+typedef cTetrisAI<FIELD_WIDTH, FIELD_HEIGHT> ai_t;
+
+static uint32_t randomState = 1;
+
+static uint8_t randomOmino(void)
+// xorshift32, so both searches get the same pieces
+{
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return(randomState % cTetromino::COUNT);
+}
+
+struct result_t
+{
+  uint32_t pieces;    // pieces placed
+  uint32_t lines;     // lines cleared
+  uint32_t lost;      // games that ended with the well full
+};
+
+static void play(const cTetromino &t, ai_t &ai, uint32_t seed, uint32_t maxPieces, result_t &r)
+// play one game, adding the pieces and lines to r
+{
+  const int8_t x0 = (FIELD_WIDTH - cTetromino::SIZE) / 2;   // where each piece enters the well
+  board_t b;
+  ai_t::move_t m;
+  uint8_t cur, nxt;
+
+  b.clear();
+  randomState = seed;
+  cur = randomOmino();
+  nxt = randomOmino();
+
+  for (uint32_t n = 0; n < maxPieces; n++)
+  {
+    if (!b.fit(t, cur, 0, x0, 0) || !ai.plan(b, cur, nxt, x0, m))
+    {
+      r.lost++;
+      break;
+    }
+
+    int8_t y = b.drop(t, cur, m.rot, m.x, 0);
+
+    b.place(t, cur, m.rot, m.x, y);
+    r.lines += b.clearLines(y);
+    r.pieces++;
+
+    cur = nxt;
+    nxt = randomOmino();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  uint32_t games = (argc > 1) ? atol(argv[1]) : 10;
+  uint32_t maxPieces = (argc > 2) ? atol(argv[2]) : 1000;
+  cTetromino t;
+  ai_t ai(t);
+
+  printf("%u games of up to %u pieces\n\n", games, maxPieces);
+  printf("%-10s %10s %10s %6s %12s %14s\n", "Search", "Pieces", "Lines", "Lost", "Placements", "Placements/s");
+
+  for (uint8_t lookahead = 0; lookahead <= 1; lookahead++)
+  {
+    result_t r = { 0, 0, 0 };
+
+    ai.setLookahead(lookahead);
+    ai.resetCount();
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t g = 0; g < games; g++)
+      play(t, ai, g + 1, maxPieces, r);
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+
+    printf("%-10s %10u %10u %6u %12u %14.3e\n", lookahead ? "Next piece" : "Current",
+      r.pieces, r.lines, r.lost, ai.evaluated(), ai.evaluated() / secs.count());
+  }
+
+  return(0);
+}
@@ -31,28 +31,32 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
 MD_MAXPanel::MD_MAXPanel(MD_MAX72XX::moduleType_t mod, uint8_t dataPin, uint8_t clkPin, uint8_t csPin, uint8_t xDevices, uint8_t yDevices) :
-_xDevices(xDevices), _yDevices(yDevices), _rotatedDisplay(false)
+_xDevices(xDevices), _yDevices(yDevices), _rotatedDisplay(false),
+_glyphCache(_glyphCacheLocal), _glyphCacheSize(GLYPH_CACHE_SIZE)
 {
   _D = new MD_MAX72XX(mod, dataPin, clkPin, csPin, xDevices*yDevices);
   _killOnDestruct = true;
 }
 
 MD_MAXPanel::MD_MAXPanel(MD_MAX72XX::moduleType_t mod, uint8_t csPin, uint8_t xDevices, uint8_t yDevices) :
-_xDevices(xDevices), _yDevices(yDevices), _rotatedDisplay(false)
+_xDevices(xDevices), _yDevices(yDevices), _rotatedDisplay(false),
+_glyphCache(_glyphCacheLocal), _glyphCacheSize(GLYPH_CACHE_SIZE)
 {
   _D = new MD_MAX72XX(mod, csPin, xDevices*yDevices);
   _killOnDestruct = true;
 }
 
 MD_MAXPanel::MD_MAXPanel(MD_MAX72XX *D, uint8_t xDevices, uint8_t yDevices) :
-_xDevices(xDevices), _yDevices(yDevices), _rotatedDisplay(false)
+_xDevices(xDevices), _yDevices(yDevices), _rotatedDisplay(false),
+_glyphCache(_glyphCacheLocal), _glyphCacheSize(GLYPH_CACHE_SIZE)
 {
   _D = D;
   _killOnDestruct = false;
 }
 
 MD_MAXPanel::MD_MAXPanel(MD_MAX72XX::moduleType_t mod, SPIClass &spi, uint8_t csPin, uint8_t xDevices, uint8_t yDevices) :
-_xDevices(xDevices), _yDevices(yDevices), _rotatedDisplay(false)
+_xDevices(xDevices), _yDevices(yDevices), _rotatedDisplay(false),
+_glyphCache(_glyphCacheLocal), _glyphCacheSize(GLYPH_CACHE_SIZE)
 {
   _D = new MD_MAX72XX(mod, spi, csPin, xDevices*yDevices);
   _killOnDestruct = true;
@@ -63,8 +67,18 @@ bool MD_MAXPanel::begin(void)
   bool b = _D->begin();
 
   _charSpacing = CHAR_SPACING_DEFAULT;
+  _textTransparent = false;
   _updateEnabled = true;
 
+  _glyphTick = 0;
+#if WIDTH_CACHE_SIZE > 0
+  _widthFont = nullptr;
+#endif
+  _packedFont = nullptr;
+  setFontWidth(_D->getMaxFontWidth());
+  _clipText = false;
+  setGlyphCache(_glyphCache, _glyphCacheSize);
+
   return(b);
 }
 
@@ -100,19 +114,11 @@ uint16_t MD_MAXPanel::getYMax(void)
 bool MD_MAXPanel::drawHLine(uint16_t y, uint16_t x1, uint16_t x2, bool state)
 // draw a horizontal line at row y between columns x1 and x2 inclusive
 {
-  bool b = true;
+  bool b;
 
   _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
 
-  if (x1 > x2)      // swap x1/x2
-  {
-    uint16_t  t = x1;
-    x1 = x2;
-    x2 = t;
-  }
-
-  for (uint16_t i = x1; i <= x2; i++)
-    b &= setPoint(i, y, state);
+  b = fillHSpan(y, x1, x2, state);
 
   update(_updateEnabled);
 
@@ -122,19 +128,11 @@ bool MD_MAXPanel::drawHLine(uint16_t y, uint16_t x1, uint16_t x2, bool state)
 bool MD_MAXPanel::drawVLine(uint16_t x, uint16_t y1, uint16_t y2, bool state)
 // draw a vertical line at column x between rows y1 and y2 inclusive
 {
-  bool b = true;
+  bool b;
 
   _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
 
-  if (y1 > y2)      // swap y1/y2
-  {
-    uint8_t  t = y1;
-    y1 = y2;
-    y2 = t;
-  }
-
-  for (uint8_t i = y1; i <= y2; i++)
-    b &= setPoint(x, i, state);
+  b = fillVSpan(x, y1, y2, state);
 
   update(_updateEnabled);
 
@@ -142,16 +140,29 @@ bool MD_MAXPanel::drawVLine(uint16_t x, uint16_t y1, uint16_t y2, bool state)
 }
 
 bool MD_MAXPanel::drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state)
-// draw an arbitrary line between two points using Bresentham's line algorithm
-// Bresentham's line algorithm at https://rosettacode.org/wiki/Bitmap/Bresenham%27s_line_algorithm#C
+// draw an arbitrary line between two points
 {
-  bool b = true;
+  bool b;
 
   _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
 
   PRINT("\n\nLine from ", x1); PRINT(",", y1);
   PRINT(" to ", x2); PRINT(",", y2);
 
+  b = drawLineSegment(x1, y1, x2, y2, state);
+
+  update(_updateEnabled);
+
+  return(b);
+}
+
+bool MD_MAXPanel::drawLineSegment(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state)
+// draw an arbitrary line between two points using Bresentham's line algorithm
+// Bresentham's line algorithm at https://rosettacode.org/wiki/Bitmap/Bresenham%27s_line_algorithm#C
+// Display updates are left to the calling method.
+{
+  bool b = true;
+
   if (x1 > x2)    // swap direction for line
   {
     uint16_t t;
@@ -189,6 +200,171 @@ bool MD_MAXPanel::drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, b
     if (e2 < dy) { err += dx; y1 += sy; }
   }
 
+  return(b);
+}
+
+bool MD_MAXPanel::drawPolyline(uint8_t n, const uint16_t *x, const uint16_t *y, bool state)
+// draw connected line segments through the n points in one batch
+{
+  bool b = true;
+
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+
+  for (uint8_t i = 1; i < n; i++)
+    b &= drawCurveSegment(x[i - 1], y[i - 1], x[i], y[i], state);
+
+  update(_updateEnabled);
+
+  return(b);
+}
+
+bool MD_MAXPanel::drawCurveSegment(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state)
+// draw one polyline segment, skipping segments that are completely off the display
+{
+  if ((x1 > getXMax() && x2 > getXMax()) || (y1 > getYMax() && y2 > getYMax()))
+    return(false);
+
+  return(drawLineSegment(x1, y1, x2, y2, state));
+}
+
+uint8_t MD_MAXPanel::curveSteps(uint32_t length)
+// Work out the number of curve steps as a power of 2 from the length of 
+// the control polygon, so that each polyline segment is a few pixels long.
+// Returns the power of 2.
+{
+  uint8_t k = 1;
+
+  while (k < CURVE_STEPS_MAX && (length >> (k + CURVE_SEGMENT_SHIFT)) != 0)
+    k++;
+
+  return(k);
+}
+
+bool MD_MAXPanel::drawQuadBezier(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, bool state)
+// Draw a quadratic Bezier curve using fixed point forward differencing.
+// P(t) = a.t^2 + b.t + c with a = P1 - 2P2 + P3, b = 2(P2 - P1), c = P1
+// For n = 2^k steps of h = 1/n the differences are
+//   dP = a.h^2 + b.h, ddP = 2a.h^2
+// The curve points are kept as fixed point offsets from P1.
+{
+  bool b = true;
+
+  if (DIST(x1, x2) > CURVE_SPAN_MAX || DIST(x1, x3) > CURVE_SPAN_MAX ||
+      DIST(y1, y2) > CURVE_SPAN_MAX || DIST(y1, y3) > CURVE_SPAN_MAX)
+    return(false);
+
+  uint8_t k = curveSteps((uint32_t)DIST(x1, x2) + DIST(y1, y2) + DIST(x2, x3) + DIST(y2, y3));
+  int32_t fx = 0, fy = 0;
+  int32_t ax = (int32_t)x1 - 2 * (int32_t)x2 + x3, ay = (int32_t)y1 - 2 * (int32_t)y2 + y3;
+  int32_t bx = 2 * ((int32_t)x2 - x1), by = 2 * ((int32_t)y2 - y1);
+  int32_t dx = FIXED(ax, CURVE_FRAC - 2 * k) + FIXED(bx, CURVE_FRAC - k);
+  int32_t dy = FIXED(ay, CURVE_FRAC - 2 * k) + FIXED(by, CURVE_FRAC - k);
+  int32_t ddx = FIXED(ax, CURVE_FRAC + 1 - 2 * k);
+  int32_t ddy = FIXED(ay, CURVE_FRAC + 1 - 2 * k);
+  uint16_t px = x1, py = y1;
+
+  PRINT("\n\nQuad Bezier steps ", 1 << k);
+
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+
+  for (uint16_t i = 1; i < (1 << k); i++)
+  {
+    uint16_t nx, ny;
+
+    fx += dx; fy += dy;
+    dx += ddx; dy += ddy;
+    nx = x1 + CURVE_ROUND(fx);
+    ny = y1 + CURVE_ROUND(fy);
+    b &= drawCurveSegment(px, py, nx, ny, state);
+    px = nx; py = ny;
+  }
+  b &= drawCurveSegment(px, py, x3, y3, state);
+
+  update(_updateEnabled);
+
+  return(b);
+}
+
+bool MD_MAXPanel::drawCubicBezier(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t x4, uint16_t y4, bool state)
+{
+  bool b;
+
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+
+  b = drawCubicSegment(x1, y1, x2, y2, x3, y3, x4, y4, state);
+
+  update(_updateEnabled);
+
+  return(b);
+}
+
+bool MD_MAXPanel::drawCubicSegment(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t x4, uint16_t y4, bool state)
+// Draw a cubic Bezier curve using fixed point forward differencing.
+// P(t) = a.t^3 + b.t^2 + c.t + d with a = -P1 + 3P2 - 3P3 + P4, 
+// b = 3P1 - 6P2 + 3P3, c = 3(P2 - P1), d = P1
+// For n = 2^k steps of h = 1/n the differences are
+//   dP = a.h^3 + b.h^2 + c.h, ddP = 6a.h^3 + 2b.h^2, dddP = 6a.h^3
+// The curve points are kept as fixed point offsets from P1.
+// Display updates are left to the calling method.
+{
+  bool r = true;
+
+  if (DIST(x1, x2) > CURVE_SPAN_MAX || DIST(x1, x3) > CURVE_SPAN_MAX || DIST(x1, x4) > CURVE_SPAN_MAX ||
+      DIST(y1, y2) > CURVE_SPAN_MAX || DIST(y1, y3) > CURVE_SPAN_MAX || DIST(y1, y4) > CURVE_SPAN_MAX)
+    return(false);
+
+  uint8_t k = curveSteps((uint32_t)DIST(x1, x2) + DIST(y1, y2) + DIST(x2, x3) + DIST(y2, y3) + DIST(x3, x4) + DIST(y3, y4));
+  int32_t fx = 0, fy = 0;
+  int32_t ax = 3 * ((int32_t)x2 - x3) + x4 - x1, ay = 3 * ((int32_t)y2 - y3) + y4 - y1;
+  int32_t bx = 3 * ((int32_t)x1 - 2 * (int32_t)x2 + x3), by = 3 * ((int32_t)y1 - 2 * (int32_t)y2 + y3);
+  int32_t cx = 3 * ((int32_t)x2 - x1), cy = 3 * ((int32_t)y2 - y1);
+  int32_t dddx = 6 * FIXED(ax, CURVE_FRAC - 3 * k), dddy = 6 * FIXED(ay, CURVE_FRAC - 3 * k);
+  int32_t ddx = dddx + FIXED(bx, CURVE_FRAC + 1 - 2 * k), ddy = dddy + FIXED(by, CURVE_FRAC + 1 - 2 * k);
+  int32_t dx = FIXED(ax, CURVE_FRAC - 3 * k) + FIXED(bx, CURVE_FRAC - 2 * k) + FIXED(cx, CURVE_FRAC - k);
+  int32_t dy = FIXED(ay, CURVE_FRAC - 3 * k) + FIXED(by, CURVE_FRAC - 2 * k) + FIXED(cy, CURVE_FRAC - k);
+  uint16_t px = x1, py = y1;
+
+  PRINT("\n\nCubic Bezier steps ", 1 << k);
+
+  for (uint16_t i = 1; i < (1 << k); i++)
+  {
+    uint16_t nx, ny;
+
+    fx += dx; fy += dy;
+    dx += ddx; dy += ddy;
+    ddx += dddx; ddy += dddy;
+    nx = x1 + CURVE_ROUND(fx);
+    ny = y1 + CURVE_ROUND(fy);
+    r &= drawCurveSegment(px, py, nx, ny, state);
+    px = nx; py = ny;
+  }
+  r &= drawCurveSegment(px, py, x4, y4, state);
+
+  return(r);
+}
+
+bool MD_MAXPanel::drawSpline(uint8_t n, const uint16_t *x, const uint16_t *y, bool state)
+// Draw a Catmull-Rom spline through the points. Each section between 
+// P[i] and P[i+1] is converted to the equivalent cubic Bezier with the
+// control points P[i] + (P[i+1] - P[i-1])/6 and P[i+1] - (P[i+2] - P[i])/6.
+// The end points are repeated to get the neighbors for the first and last 
+// sections.
+{
+  bool b = true;
+
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+
+  for (uint8_t i = 0; i + 1 < n; i++)
+  {
+    uint8_t i0 = (i == 0 ? 0 : i - 1);
+    uint8_t i3 = (i + 2 < n ? i + 2 : n - 1);
+
+    b &= drawCubicSegment(x[i], y[i],
+      SPLINE_CTRL(x[i], x[i + 1], x[i0]), SPLINE_CTRL(y[i], y[i + 1], y[i0]),
+      SPLINE_CTRL(x[i + 1], x[i], x[i3]), SPLINE_CTRL(y[i + 1], y[i], y[i3]),
+      x[i + 1], y[i + 1], state);
+  }
+
   update(_updateEnabled);
 
   return(b);
@@ -213,18 +389,21 @@ bool MD_MAXPanel::drawRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
   return(b);
 }
 
-bool MD_MAXPanel::drawFillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state)
+bool MD_MAXPanel::drawFillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state, const uint8_t *pattern)
+// draw a filled rectangle as one span per column byte direction
 {
   bool b = true;
-  bool u = _updateEnabled;
 
   _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
-  update(false);
 
-  for (uint8_t i = x1; i <= x2; i++)
-    drawVLine(i, y1, y2, state);
+  toSpan(x1, y1);
+  toSpan(x2, y2);
+  if (x1 > x2) { uint16_t t = x1; x1 = x2; x2 = t; }
 
-  update(u);
+  for (uint16_t a = x1; a <= x2; a++)
+    b &= fillByteSpan(a, y1, y2, state, pattern);
+
+  update(_updateEnabled);
 
   return(b);
 };
@@ -348,7 +527,7 @@ bool MD_MAXPanel::drawFillTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16
 }
 */
 
-bool MD_MAXPanel::drawFillTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, bool state)
+bool MD_MAXPanel::drawFillTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, bool state, const uint8_t *pattern)
 // Fill a triangle - Bresenham method
 // Original from http://www.sunshine2k.de/coding/java/TriangleRasterization/TriangleRasterization.html
 {
@@ -437,7 +616,7 @@ bool MD_MAXPanel::drawFillTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16
     if (minx>t2x) minx = t2x;
     if (maxx<t1x) maxx = t1x; 
     if (maxx<t2x) maxx = t2x;
-    b &= drawHLine(y, minx, maxx, state); // Draw line from min to max points found on the y
+    b &= fillHSpan(y, minx, maxx, state, pattern); // Draw line from min to max points found on the y
     // Now increase y
     if (!changed1) t1x += signx1;
     t1x += t1xp;
@@ -503,7 +682,7 @@ bool MD_MAXPanel::drawFillTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16
     if (minx>t2x) minx = t2x;
     if (maxx<t1x) maxx = t1x; 
     if (maxx<t2x) maxx = t2x;
-    b &= drawHLine(y, minx, maxx, state);    // Draw line from min to max points found on the y
+    b &= fillHSpan(y, minx, maxx, state, pattern);    // Draw line from min to max points found on the y
     // Now increase y
     if (!changed1) t1x += signx1;
     t1x += t1xp;
@@ -520,6 +699,243 @@ outtahere:
 }
 
 
+bool MD_MAXPanel::drawThickLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t w, bool state)
+// Draw a thick line as the rectangle w pixels wide around the line centre, 
+// extended half a pixel past each end point so that the end points are 
+// covered. The rectangle vertices are worked out in 1/16 pixel fixed point
+// and it is filled with spans.
+{
+  int32_t a[2], b[2], da, db, na, nb, ea, eb;
+  int32_t va[4], vb[4];
+  uint32_t len;
+  bool r;
+
+  if (w <= 1)
+    return(drawLine(x1, y1, x2, y2, state));
+
+  toSpan(x1, y1);
+  toSpan(x2, y2);
+  a[0] = (int32_t)x1 << SPAN_FRAC; b[0] = (int32_t)y1 << SPAN_FRAC;
+  a[1] = (int32_t)x2 << SPAN_FRAC; b[1] = (int32_t)y2 << SPAN_FRAC;
+  da = a[1] - a[0];
+  db = b[1] - b[0];
+
+  // Only the part of the line within w pixels of the panel can be seen. 
+  // Clipping it there, and only keeping the direction of very long lines to
+  // 16 bits, keeps the fixed point products below in 32 bits.
+  if (!clipSpanLine(a, b, (int32_t)w << SPAN_FRAC))
+    return(false);
+  while (da > INT16_MAX || da < -INT16_MAX || db > INT16_MAX || db < -INT16_MAX)
+  {
+    da /= 2;
+    db /= 2;
+  }
+  len = isqrt((uint32_t)(da * da) + (uint32_t)(db * db));  // length in 1/16 pixel
+
+  if (len == 0)     // just a point, make a w x w square
+  {
+    na = 0; nb = (w << SPAN_FRAC) / 2;
+    ea = nb; eb = 0;
+  }
+  else
+  {
+    // normal and end extensions scaled to half width and half a pixel
+    na = (-db * (w << SPAN_FRAC)) / (int32_t)(2 * len);
+    nb = (da * (w << SPAN_FRAC)) / (int32_t)(2 * len);
+    ea = (da * (1 << SPAN_FRAC)) / (int32_t)(2 * len);
+    eb = (db * (1 << SPAN_FRAC)) / (int32_t)(2 * len);
+  }
+
+  a[0] -= ea; b[0] -= eb;
+  a[1] += ea; b[1] += eb;
+  va[0] = a[0] + na; vb[0] = b[0] + nb;
+  va[1] = a[1] + na; vb[1] = b[1] + nb;
+  va[2] = a[1] - na; vb[2] = b[1] - nb;
+  va[3] = a[0] - na; vb[3] = b[0] - nb;
+
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+
+  r = fillConvexQuad(va, vb, state);
+
+  update(_updateEnabled);
+
+  return(r);
+}
+
+bool MD_MAXPanel::clipSpanLine(int32_t *a, int32_t *b, int32_t m)
+// Clip the line from (a[0], b[0]) to (a[1], b[1]) in 1/16 pixel span coordinates 
+// to the panel extended by m on all sides, moving one end to an edge at a time 
+// (Cohen-Sutherland). Return false if the line is all outside. The products 
+// need 64 bits, but are only worked out for lines that reach outside.
+{
+  const int32_t aLo = -m, aHi = ((int32_t)(_xDevices * COL_SIZE - 1) << SPAN_FRAC) + m;
+  const int32_t bLo = -m, bHi = ((int32_t)(_yDevices * ROW_SIZE - 1) << SPAN_FRAC) + m;
+  uint8_t code[2];
+
+  for (;;)
+  {
+    for (uint8_t i = 0; i < 2; i++)
+      code[i] = (a[i] < aLo ? 1 : 0) | (a[i] > aHi ? 2 : 0) | (b[i] < bLo ? 4 : 0) | (b[i] > bHi ? 8 : 0);
+
+    if ((code[0] | code[1]) == 0)   // all inside
+      return(true);
+    if ((code[0] & code[1]) != 0)   // all outside
+      return(false);
+
+    uint8_t i = (code[0] != 0) ? 0 : 1;
+    int64_t da = a[1 - i] - a[i];
+    int64_t db = b[1 - i] - b[i];
+
+    if (code[i] & 1)      { b[i] += (db * (aLo - a[i])) / da; a[i] = aLo; }
+    else if (code[i] & 2) { b[i] += (db * (aHi - a[i])) / da; a[i] = aHi; }
+    else if (code[i] & 4) { a[i] += (da * (bLo - b[i])) / db; b[i] = bLo; }
+    else                  { a[i] += (da * (bHi - b[i])) / db; b[i] = bHi; }
+  }
+}
+
+bool MD_MAXPanel::fillConvexQuad(const int32_t *va, const int32_t *vb, bool state)
+// Fill the convex quadrilateral with vertices in 1/16 pixel span coordinates,
+// one span for each column of pixel centres inside the shape.
+{
+  const int16_t aMax = _xDevices * COL_SIZE - 1;
+  int32_t aLo = va[0], aHi = va[0];
+  bool r = true;
+
+  for (uint8_t i = 1; i < 4; i++)
+  {
+    if (va[i] < aLo) aLo = va[i];
+    if (va[i] > aHi) aHi = va[i];
+  }
+  aLo = SPAN_CEIL(aLo);
+  aHi = SPAN_CEIL(aHi) - 1;
+  if (aLo < 0) { aLo = 0; r = false; }
+  if (aHi > aMax) { aHi = aMax; r = false; }
+
+  for (int32_t a = aLo; a <= aHi; a++)
+  {
+    int32_t A = a << SPAN_FRAC;
+    int32_t lo = INT32_MAX, hi = INT32_MIN;
+
+    // find where the column crosses the edges
+    for (uint8_t i = 0; i < 4; i++)
+    {
+      uint8_t j = (i + 1) % 4;
+      int32_t v;
+
+      if (va[i] == va[j] || A < min(va[i], va[j]) || A > max(va[i], va[j]))
+        continue;
+
+      v = vb[i] + ((vb[j] - vb[i]) * (A - va[i])) / (va[j] - va[i]);
+      if (v < lo) lo = v;
+      if (v > hi) hi = v;
+    }
+
+    if (lo <= hi && SPAN_CEIL(lo) <= SPAN_CEIL(hi) - 1)
+      r &= fillByteSpan(a, SPAN_CEIL(lo), SPAN_CEIL(hi) - 1, state);
+  }
+
+  return(r);
+}
+
+bool MD_MAXPanel::drawRoundRect(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t r, bool state)
+// Draw the outline of a rounded rectangle as spans. In each column the top
+// and bottom spans reach across to the edge of the neighboring columns so
+// that the corners are connected, and each pixel is set once.
+{
+  bool b = true;
+
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+
+  toSpan(x1, y1);
+  toSpan(x2, y2);
+  if (x1 > x2) { uint16_t t = x1; x1 = x2; x2 = t; }
+  if (y1 > y2) { uint16_t t = y1; y1 = y2; y2 = t; }
+  r = min(r, (uint16_t)(min(x2 - x1, y2 - y1) / 2));
+
+  for (uint16_t a = x1; a <= x2; a++)
+  {
+    int16_t t = y1 + roundRectInset(a - x1, x2 - a, r);
+    int16_t u = y2 - roundRectInset(a - x1, x2 - a, r);
+
+    if (a != x1 && a != x2)
+    {
+      // extend the spans to meet the neighbors
+      uint16_t in = max(roundRectInset(a - 1 - x1, x2 - a + 1, r), roundRectInset(a + 1 - x1, x2 - a - 1, r));
+      int16_t te = max(t, (int16_t)(y1 + in - 1));
+      int16_t ue = min(u, (int16_t)(y2 - in + 1));
+
+      if (te + 1 < ue)
+      {
+        b &= fillByteSpan(a, t, te, state);
+        b &= fillByteSpan(a, ue, u, state);
+        continue;
+      }
+    }
+    b &= fillByteSpan(a, t, u, state);   // whole column
+  }
+
+  update(_updateEnabled);
+
+  return(b);
+}
+
+bool MD_MAXPanel::drawFillRoundRect(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t r, bool state, const uint8_t *pattern)
+// Draw a filled rounded rectangle as one span per column
+{
+  bool b = true;
+
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+
+  toSpan(x1, y1);
+  toSpan(x2, y2);
+  if (x1 > x2) { uint16_t t = x1; x1 = x2; x2 = t; }
+  if (y1 > y2) { uint16_t t = y1; y1 = y2; y2 = t; }
+  r = min(r, (uint16_t)(min(x2 - x1, y2 - y1) / 2));
+
+  for (uint16_t a = x1; a <= x2; a++)
+  {
+    uint16_t in = roundRectInset(a - x1, x2 - a, r);
+
+    b &= fillByteSpan(a, y1 + in, y2 - in, state, pattern);
+  }
+
+  update(_updateEnabled);
+
+  return(b);
+}
+
+uint16_t MD_MAXPanel::roundRectInset(uint16_t d1, uint16_t d2, uint16_t r)
+// Inset of the rounded rectangle edge for a column d1 and d2 pixels from the 
+// ends. The corners are quarter circles with the same pixels as drawFillCircle(),
+// found by walking the Bresenham circle octant for the column.
+{
+  uint16_t d = min(d1, d2);
+  int16_t x = 0, y = r;
+  int16_t pk = 3 - (2 * r);
+  uint16_t h = 0;
+
+  if (d >= r) return(0);
+
+  d = r - d;          // distance from the corner circle center
+  for (;;)
+  {
+    if (x == d && y > h) h = y;
+    if (y == d && x > h) h = x;
+    if (x >= y) break;
+
+    if (pk <= 0)
+      pk = pk + (4 * x) + 6;
+    else
+    {
+      pk = pk + (4 * (x - y)) + 10;
+      y--;
+    }
+    x++;
+  }
+
+  return(r - h);
+}
+
 bool MD_MAXPanel::drawCirclePoints(uint16_t xc, uint16_t yc, uint16_t x, uint16_t y, bool state)
 // draw symmetrical circle points
 {
@@ -571,53 +987,174 @@ bool MD_MAXPanel::drawCircle(uint16_t xc, uint16_t yc, uint16_t r, bool state)
   return(b);
 }
 
-bool MD_MAXPanel::drawCircleLines(uint16_t xc, uint16_t yc, uint16_t x, uint16_t y, bool state)
-// draw symmetrical circle lines for the filled circle
+bool MD_MAXPanel::fillCircleSpans(int16_t a, int16_t b, int16_t d, int16_t h, bool state, const uint8_t *pattern)
+// fill the symmetrical circle spans d columns either side of the center
 {
-  bool b = true;
+  bool r = true;
 
-  b &= drawHLine(yc - y, xc - x, xc + x, state);
-  b &= drawHLine(yc + y, xc - x, xc + x, state);
-  b &= drawHLine(yc - x, xc - y, xc + y, state);
-  b &= drawHLine(yc + x, xc - y, xc + y, state);
+  r &= fillByteSpan(a - d, b - h, b + h, state, pattern);
+  if (d != 0)
+    r &= fillByteSpan(a + d, b - h, b + h, state, pattern);
 
-  return(b);
+  return(r);
 }
 
-bool MD_MAXPanel::drawFillCircle(uint16_t xc, uint16_t yc, uint16_t r, bool state)
+bool MD_MAXPanel::drawFillCircle(uint16_t xc, uint16_t yc, uint16_t r, bool state, const uint8_t *pattern)
 // Draw a filled circle given center and radius
 // Bresenhams Algorith from http://www.pracspedia.com/CG/bresenhamcircle.html
+// Each column of the circle is filled once as a span in the byte direction. 
+// The spans for columns y from the center are filled with the last x on that 
+// column, when y is about to change.
 {
   int x = 0, y = r;
   int pk = 3 - (2 * r);
-  bool b = false;
-  bool u = _updateEnabled;
+  bool b = true;
 
   _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
-  update(false);
 
   PRINT("\n\nFilled Circle center ", xc); PRINT(",", yc); PRINT(" radius ", r);
-  b &= drawCircleLines(xc, yc, x, y, state);
+  toSpan(xc, yc);
+  b &= fillCircleSpans(xc, yc, x, y, state, pattern);
   while (x < y)
   {
     // check for decision parameter and correspondingly update pk, x, y
     if (pk <= 0)
-    {
       pk = pk + (4 * x) + 6;
-      b &= drawCircleLines(xc, yc, ++x, y, state);
-    }
     else
     {
+      b &= fillCircleSpans(xc, yc, y, x, state, pattern);
       pk = pk + (4 * (x - y)) + 10;
-      b &= drawCircleLines(xc, yc, ++x, --y, state);
+      y--;
     }
+    b &= fillCircleSpans(xc, yc, ++x, y, state, pattern);
   }
+  b &= fillCircleSpans(xc, yc, y, x, state, pattern);
 
-  update(u);
+  update(_updateEnabled);
 
   return(b);
 }
 
+uint8_t *MD_MAXPanel::getBayerPattern(uint8_t *pattern, uint8_t level)
+// Create the 8x8 Bayer ordered dither pattern with level pixels set. The 
+// Bayer matrix value for (x,y) is the bit reversed interleave of x^y and y.
+{
+  for (uint8_t y = 0; y < ROW_SIZE; y++)
+  {
+    pattern[y] = 0;
+    for (uint8_t x = 0; x < COL_SIZE; x++)
+    {
+      uint8_t m = 0;
+
+      for (uint8_t i = 0; i < 3; i++)
+        m = (m << 2) | ((((x ^ y) >> i) & 1) << 1) | ((y >> i) & 1);
+
+      if (m < level)
+        pattern[y] |= (1 << x);
+    }
+  }
+
+  return(pattern);
+}
+
+bool MD_MAXPanel::floodFill(uint16_t x, uint16_t y, bool state)
+// Span filling flood fill with a fixed size seed stack
+// Adapted from Heckbert's seed fill, see https://en.wikipedia.org/wiki/Flood_fill#Span_filling
+// The fill works in physical panel coordinates where each vertical span 
+// is a run of bits in the module column bytes, so spans are read and 
+// written directly in the module data independent of the display rotation.
+{
+  const uint16_t H = _yDevices * ROW_SIZE;
+  fillStack_t s;
+
+  if (x > getXMax() || y > getYMax())
+    return(false);
+
+  PRINT("\n\nFlood fill from ", x); PRINT(",", y);
+
+  toPhysical(x, y);
+  if (!fillInside(x, y, state))    // already filled
+    return(true);
+
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+
+  s.count = 0;
+  s.dropped = false;
+  fillPush(s, x, y, y, 1);
+  fillPush(s, x - 1, y, y, -1);
+
+  while (s.count != 0)
+  {
+    uint16_t px, y1, y2, py;
+    int8_t dx;
+
+    s.count--;
+    px = s.seed[s.count].x;
+    y1 = s.seed[s.count].y1;
+    y2 = s.seed[s.count].y2;
+    dx = s.seed[s.count].dx;
+    py = y1;
+
+    if (fillInside(px, py, state))  // extend the run backwards
+    {
+      while (py > 0 && fillInside(px, py - 1, state))
+        py--;
+      if (py < y1) fillPush(s, px - dx, py, y1 - 1, -dx);
+    }
+
+    while (y1 <= y2)
+    {
+      while (y1 < H && fillInside(px, y1, state))
+        y1++;
+      if (y1 > py)    // found a run to fill
+      {
+        fillPhysSpan(px, py, y1 - 1, state);
+        fillPush(s, px + dx, py, y1 - 1, dx);
+        if (y1 - 1 > y2) fillPush(s, px - dx, y2 + 1, y1 - 1, -dx);
+      }
+      y1++;
+      while (y1 < y2 && !fillInside(px, y1, state))
+        y1++;
+      py = y1;
+    }
+  }
+
+  update(_updateEnabled);
+
+  return(!s.dropped);
+}
+
+bool MD_MAXPanel::fillInside(uint16_t px, uint16_t py, bool state)
+// True if the physical point is on the panel and not yet set to state
+{
+  if (px >= _xDevices * COL_SIZE || py >= _yDevices * ROW_SIZE)
+    return(false);
+
+  return(getPhysPoint(px, py) != state);
+}
+
+void MD_MAXPanel::fillPush(fillStack_t &s, uint16_t px, uint16_t py1, uint16_t py2, int8_t dx)
+// Push a seed on the flood fill stack or note that it was dropped.
+// Seeds for columns outside the panel are ignored.
+{
+  if (px >= _xDevices * COL_SIZE)
+    return;
+
+  if (s.count < FILL_STACK_SIZE)
+  {
+    s.seed[s.count].x = px;
+    s.seed[s.count].y1 = py1;
+    s.seed[s.count].y2 = py2;
+    s.seed[s.count].dx = dx;
+    s.count++;
+  }
+  else
+  {
+    PRINT("\nFill seed dropped at column ", px);
+    s.dropped = true;
+  }
+}
+
 uint16_t MD_MAXPanel::Y2Row(uint16_t x, uint16_t y)
 // Convert y coord to linear coord
 {
@@ -668,3 +1205,252 @@ bool MD_MAXPanel::setPoint(uint16_t x, uint16_t y, bool state)
   return(_D->setPoint(Y2Row(x,y), X2Col(x,y), state));
 }
 
+bool MD_MAXPanel::scrollLeft(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t col, bool state)
+// Scroll the area left by one pixel, moving module column bytes, and feed in the 
+// new column at x2.
+{
+  bool b = true;
+
+  if (x1 > x2) { uint16_t t = x1; x1 = x2; x2 = t; }
+  if (y1 > y2) { uint16_t t = y1; y1 = y2; y2 = t; }
+  if (x1 > getXMax() || y1 > getYMax()) return(false);
+  if (x2 > getXMax()) { x2 = getXMax(); b = false; }
+  if (y2 > getYMax()) { y2 = getYMax(); b = false; }
+
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+
+  if (!_rotatedDisplay)
+  {
+    // Display columns are physical columns, so copy the area bits of each 
+    // module row from the column on the right.
+    for (uint16_t r = y1 / ROW_SIZE; r <= y2 / ROW_SIZE; r++)
+    {
+      uint8_t lo = (r == y1 / ROW_SIZE) ? y1 % ROW_SIZE : 0;
+      uint8_t hi = (r == y2 / ROW_SIZE) ? y2 % ROW_SIZE : ROW_SIZE - 1;
+      uint8_t mask = (uint8_t)(0xff >> lo) & (uint8_t)(0xff << (ROW_SIZE - 1 - hi));
+      uint16_t c = physColumn(x1, r * ROW_SIZE);
+      uint8_t v = _D->getColumn(c);
+
+      for (uint16_t x = x1; x < x2; x++, c--)   // physical column x + 1 is c - 1
+      {
+        uint8_t next = _D->getColumn(c - 1);
+
+        _D->setColumn(c, (v & ~mask) | (next & mask));
+        v = next;
+      }
+    }
+  }
+  else if (x1 < x2)
+  {
+    // Display columns run along the physical column bytes in reverse, so shift
+    // the bits of each physical column one place towards the higher rows, 
+    // working down from the top module so the carry is from unchanged data.
+    const uint16_t bMax = getXMax();
+    const uint16_t pLo = bMax - x2 + 1;    // x2 - 1 moves here
+    const uint16_t pHi = bMax - x1;
+
+    for (uint16_t px = y1; px <= y2; px++)
+    {
+      for (int16_t r = pHi / ROW_SIZE; r >= (int16_t)(pLo / ROW_SIZE); r--)
+      {
+        uint16_t lo = max(pLo, (uint16_t)(r * ROW_SIZE));
+        uint16_t hi = min(pHi, (uint16_t)((r * ROW_SIZE) + ROW_SIZE - 1));
+        uint8_t mask = (uint8_t)(0xff >> (lo % ROW_SIZE)) & (uint8_t)(0xff << (ROW_SIZE - 1 - (hi % ROW_SIZE)));
+        uint16_t c = physColumn(px, r * ROW_SIZE);
+        uint8_t v = _D->getColumn(c);
+        uint8_t shifted = v >> 1;
+
+        if (lo == r * ROW_SIZE)   // top bit comes from the module row below
+          shifted |= (_D->getColumn(physColumn(px, (r - 1) * ROW_SIZE)) & 1) << (ROW_SIZE - 1);
+
+        _D->setColumn(c, (v & ~mask) | (shifted & mask));
+      }
+    }
+  }
+
+  // feed in the new column
+  for (uint16_t y = y2, i = 0; y >= y1 && y <= y2; y--, i++)
+    setPoint(x2, y, (i < ROW_SIZE && (col & (1 << i))) ? state : !state);
+
+  update(_updateEnabled);
+
+  return(b);
+}
+
+void MD_MAXPanel::toPhysical(uint16_t &x, uint16_t &y)
+// Convert display coordinates to physical (unrotated) panel coordinates
+{
+  if (_rotatedDisplay)
+  {
+    uint16_t t = x;
+
+    x = y;
+    y = getXMax() - t;
+  }
+}
+
+uint16_t MD_MAXPanel::physColumn(uint16_t px, uint16_t py)
+// Module column holding the physical point
+{
+  return((((py / ROW_SIZE) + 1) * (_xDevices * COL_SIZE)) - 1 - px);
+}
+
+bool MD_MAXPanel::getPhysPoint(uint16_t px, uint16_t py)
+{
+  return((_D->getColumn(physColumn(px, py)) & PHYS_BIT(py)) != 0);
+}
+
+void MD_MAXPanel::toSpan(uint16_t &x, uint16_t &y)
+// Convert display coordinates to span coordinates (a, b), where spans along 
+// b are in the direction of the module column bytes.
+{
+  if (_rotatedDisplay)
+  {
+    uint16_t t = x;
+
+    x = y;
+    y = t;
+  }
+}
+
+bool MD_MAXPanel::fillByteSpan(int16_t a, int16_t b1, int16_t b2, bool state, const uint8_t *pattern)
+// Fill the span from b1 to b2 inclusive at a in span coordinates, clipped to the 
+// display. This is a vertical line for an unrotated display and a horizontal line 
+// for a rotated display, and is set a whole module column byte at a time.
+// Return false if the span was clipped.
+{
+  const int16_t aMax = _xDevices * COL_SIZE - 1;
+  const int16_t bMax = _yDevices * ROW_SIZE - 1;
+  bool b = true;
+
+  if (b1 > b2) { int16_t t = b1; b1 = b2; b2 = t; }
+
+  if (a < 0 || a > aMax || b2 < 0 || b1 > bMax)
+    return(false);
+
+  if (b1 < 0) { b1 = 0; b = false; }
+  if (b2 > bMax) { b2 = bMax; b = false; }
+
+  if (_rotatedDisplay)
+    fillPhysSpan(a, bMax - b2, bMax - b1, state, patternMask(a, pattern));
+  else
+    fillPhysSpan(a, b1, b2, state, patternMask(a, pattern));
+
+  return(b);
+}
+
+bool MD_MAXPanel::fillCrossSpan(int16_t b, int16_t a1, int16_t a2, bool state, const uint8_t *pattern)
+// Fill the span from a1 to a2 inclusive at b in span coordinates, clipped to the 
+// display. This is across the module column bytes, so one bit is set in each 
+// column. Return false if the span was clipped.
+{
+  const int16_t aMax = _xDevices * COL_SIZE - 1;
+  const int16_t bMax = _yDevices * ROW_SIZE - 1;
+  bool r = true;
+
+  if (a1 > a2) { int16_t t = a1; a1 = a2; a2 = t; }
+
+  if (b < 0 || b > bMax || a2 < 0 || a1 > aMax)
+    return(false);
+
+  if (a1 < 0) { a1 = 0; r = false; }
+  if (a2 > aMax) { a2 = aMax; r = false; }
+
+  const uint16_t py = _rotatedDisplay ? bMax - b : b;
+  const uint8_t bit = PHYS_BIT(py);
+
+  for (int16_t a = a1; a <= a2; a++)
+  {
+    if (pattern != nullptr)   // pattern bit for display point (a,b) or (b,a)
+    {
+      bool on = _rotatedDisplay ? (pattern[a % ROW_SIZE] & bit) : (pattern[py % ROW_SIZE] & (1 << (a % COL_SIZE)));
+
+      if (!on) continue;
+    }
+
+    const uint16_t c = physColumn(a, py);
+    const uint8_t v = _D->getColumn(c);
+
+    _D->setColumn(c, state ? (v | bit) : (v & ~bit));
+  }
+
+  return(r);
+}
+
+bool MD_MAXPanel::fillHSpan(uint16_t y, uint16_t x1, uint16_t x2, bool state, const uint8_t *pattern)
+// Fill a clipped horizontal span in display coordinates
+{
+  if (_rotatedDisplay)
+    return(fillByteSpan(y, x1, x2, state, pattern));
+  else
+    return(fillCrossSpan(y, x1, x2, state, pattern));
+}
+
+bool MD_MAXPanel::fillVSpan(uint16_t x, uint16_t y1, uint16_t y2, bool state, const uint8_t *pattern)
+// Fill a clipped vertical span in display coordinates
+{
+  if (_rotatedDisplay)
+    return(fillCrossSpan(x, y1, y2, state, pattern));
+  else
+    return(fillByteSpan(x, y1, y2, state, pattern));
+}
+
+uint8_t MD_MAXPanel::patternMask(uint16_t px, const uint8_t *pattern)
+// Module column byte mask for physical column px of the fill pattern. Pattern 
+// rows are display y and bits are display x. For a rotated display the physical 
+// column is a display row and the bits are already in column byte order, as 
+// getXMax() is always 7 modulo 8.
+{
+  uint8_t m = 0;
+
+  if (pattern == nullptr)
+    return(0xff);
+
+  if (_rotatedDisplay)
+    return(pattern[px % ROW_SIZE]);
+
+  for (uint8_t i = 0; i < ROW_SIZE; i++)
+    if (pattern[i] & (1 << (px % COL_SIZE)))
+      m |= PHYS_BIT(i);
+
+  return(m);
+}
+
+uint32_t MD_MAXPanel::isqrt(uint32_t v)
+// Integer square root (rounded down) by the binary digit method
+{
+  uint32_t r = 0;
+  uint32_t bit = 1UL << 30;
+
+  while (bit > v) bit >>= 2;
+
+  while (bit != 0)
+  {
+    if (v >= r + bit)
+    {
+      v -= r + bit;
+      r = (r >> 1) + bit;
+    }
+    else
+      r >>= 1;
+    bit >>= 2;
+  }
+
+  return(r);
+}
+
+void MD_MAXPanel::fillPhysSpan(uint16_t px, uint16_t py1, uint16_t py2, bool state, uint8_t pmask)
+// Set the physical vertical run py1 to py2 inclusive, one module column byte at a time.
+// Only the bits in the pattern mask pmask are changed.
+{
+  while (py1 <= py2)
+  {
+    uint16_t c = physColumn(px, py1);
+    uint8_t end = (py1 / ROW_SIZE == py2 / ROW_SIZE) ? (py2 % ROW_SIZE) : ROW_SIZE - 1;
+    uint8_t mask = (uint8_t)(0xff >> (py1 % ROW_SIZE)) & (uint8_t)(0xff << (ROW_SIZE - 1 - end)) & pmask;
+    uint8_t v = _D->getColumn(c);
+
+    _D->setColumn(c, state ? (v | mask) : (v & ~mask));
+    py1 = ((py1 / ROW_SIZE) + 1) * ROW_SIZE;    // start of the next module
+  }
+}
@@ -9,6 +9,66 @@
  * \brief Main header file for the MD_MAXPanel library
  */
 
+// Library settings.
+// The library is compiled separately from the sketch, so these values can 
+// only be changed by editing this file. Defining them in the sketch has no 
+// effect on the library code.
+
+/**
+ * Size of the floodFill() seed stack.
+ *
+ * Each seed uses 7 bytes of stack while the fill is running. Complex
+ * shapes need more seeds; when the stack overflows some of the area is
+ * left unfilled and floodFill() returns false. The size must be less
+ * than 256.
+ */
+#define FILL_STACK_SIZE 32
+
+/**
+ * Number of characters held in the built in drawText() glyph cache.
+ *
+ * Each entry uses about 8 bytes plus the glyph data (8 bytes for the default
+ * GLYPH_CACHE_WIDTH) in each MD_MAXPanel object. The cache must hold at least
+ * one glyph, as the entries are also used to prepare the character being drawn.
+ * On AVR the built in cache only keeps the last character, to save RAM, and a 
+ * sketch that redraws text often, such as a clock, can give the object a bigger
+ * cache with setGlyphCache().
+ */
+#if defined(__AVR__)
+#define GLYPH_CACHE_SIZE 1
+#else
+#define GLYPH_CACHE_SIZE 8
+#endif
+
+/**
+ * Widest font character, in pixels, that can be held in the glyph cache.
+ *
+ * Text in a font with characters wider than this is not cached.
+ */
+#define GLYPH_CACHE_WIDTH 8
+
+/**
+ * Widest font character, in pixels, that can be drawn by the text methods.
+ *
+ * The columns of each character are read from the font into a fixed size 
+ * buffer in the MD_MAXPanel object, so the stack used by the text methods 
+ * does not depend on the font. The buffer uses 1 byte of RAM for each pixel,
+ * in each MD_MAXPanel and MD_MAXPanel_Scroller object. setFont() and
+ * setPackedFont() check the font against this limit.
+ */
+#define FONT_WIDTH_MAX 16
+
+/**
+ * Number of character widths held in the text width cache.
+ *
+ * Character widths for the current font are cached so that text can be measured
+ * without reading the font. Each entry uses 3 bytes of RAM in each MD_MAXPanel
+ * object. The default of 0 leaves out the cache and reads each width from the 
+ * font. A cache of 32 entries suits text that is measured often, such as with 
+ * drawTextBox().
+ */
+#define WIDTH_CACHE_SIZE 0
+
 /**
 \mainpage Arduino LED Matrix Panel Library
 The MD_MAXPanel Library
@@ -71,6 +131,22 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
 
 \page pageRevisionHistory Revision History
+Oct 2026 version 1.5.0
+- Added floodFill()
+- Added drawPolyline(), drawQuadBezier(), drawCubicBezier() and drawSpline()
+- Added drawThickLine(), drawRoundRect() and drawFillRoundRect()
+- Added fill patterns and getBayerPattern()
+- Added glyph cache for drawText()
+- Added transparent text with setTextTransparent()
+- Added scrollLeft() and the MD_MAXPanel_Scroller class for scrolling text
+- Added drawTextBox() and getCharWidth(), with a character width cache
+- Added drawTextChanges() to redraw only the changed characters of text
+- Added scale factor to drawText() for large text from small fonts
+- Added packed fonts with setPackedFont() and the FontPack tool
+- Added UTF-8 text and 16 bit character codes in packed fonts
+- Added drawNumber() and drawTime() to draw numbers without formatting a string
+- Text methods read characters into a fixed FONT_WIDTH_MAX buffer, checked by setFont()
+
 Jun 2023 version 1.4.0
 - begin() returns bool value
 - Added Scoreboard examples SB_Simple and SB_BBall
@@ -129,6 +205,31 @@ In trigonometric terms, the display is located in the first quadrant.
 
 The library is relies on the related MD_MAX72xx library to provide the
 device control elements.
+
+Scrolling Text
+--------------
+The MD_MAXPanel_Scroller class scrolls a message right to left through a band
+of the display. Each step moves the band one pixel to the left and feeds in the
+next column of the message, so the message text is not redrawn. The scroller is
+driven by calling its tick() method from loop(). Several scroller objects can be 
+used together to scroll different messages in separate bands of the display.
+
+Packed Fonts
+------------
+Text can use MD_MAX72xx fonts or fonts in a packed format that takes less flash
+memory. Packed fonts are made from MD_MAX72xx font tables by the FontPack tool 
+in the library extras folder
+
+    python3 extras/FontPack/fontpack.py Font5x3.h > Font5x3_Packed.h
+
+and selected with setPackedFont(). The characters are unpacked as they are drawn
+or measured, so the glyph and width caches hide most of the extra work.
+
+Text is read as UTF-8, so characters beyond ASCII can be written directly in
+the sketch source. Packed fonts can have characters anywhere in the 16 bit 
+Unicode range, by combining 8 bit MD_MAX72xx fonts with a code offset for each
+
+    python3 extras/FontPack/fontpack.py Font5x3.h Greek5x3.h:0x381 > Font5x3_Packed.h
 */
 
 /**
@@ -154,6 +255,18 @@ public:
     ROT_180,  ///< Rotation 180 degrees
     ROT_270,  ///< Rotation 270 degrees
   };
+
+  /**
+  * Text alignment enumerated type specification.
+  *
+  * Used to define the alignment of the lines of text in drawTextBox().
+  */
+  enum textAlign_t
+  {
+    ALIGN_LEFT,   ///< Lines start at the left edge of the box
+    ALIGN_CENTER, ///< Lines are centered in the box
+    ALIGN_RIGHT,  ///< Lines end at the right edge of the box
+  };
   
   /**
    * Class Constructor - arbitrary digital interface.
@@ -260,8 +373,9 @@ public:
   * \param x2 the lower right x coordinate of the window
   * \param y2 the upper lower right y coordinate of the window
   * \param state true - switch pixels on; false - switch pixels off. If omitted, default to false.
+  * \param pattern optional 8 byte fill pattern, as described for drawFillRectangle(). If omitted, the whole area is cleared.
   */
-  void clear(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state = false) { for (uint8_t i=x1; i<=x2; i++) drawVLine(i, y1, y2, state); };
+  void clear(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state = false, const uint8_t *pattern = nullptr) { drawFillRectangle(x1, y1, x2, y2, state, pattern); };
 
   /**
   * Get a pointer to the instantiated graphics object.
@@ -378,6 +492,24 @@ public:
    */
   bool drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state = true);
 
+  /**
+   * Draw a thick line between two points on the display
+   *
+   * Draw a line w pixels wide centered on the line between the specified 
+   * points. The ends of the line are square and cover the end points. The 
+   * LEDs covered by the line are worked out as spans and each LED is set once.
+   * A width of 0 or 1 draws the same line as drawLine().
+   *
+   * \param x1    starting x coordinate for the point [0..getXMax()].
+   * \param y1    starting y coordinate for the point [0..getYMax()].
+   * \param x2    ending x coordinate for the point [0..getXMax()].
+   * \param y2    ending y coordinate for the point [0..getYMax()].
+   * \param w     the width of the line in pixels.
+   * \param state true - switch on; false - switch off. If omitted, default to true.
+   * \return false if any point is drawn outside the display, true otherwise.
+   */
+  bool drawThickLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t w, bool state = true);
+
   /**
   * Draw a vertical line between two points on the display
   *
@@ -419,14 +551,62 @@ public:
   * The coordinates will be dereferenced into the device and column within the 
   * device, allowing the LEDs to be treated as a continuous pixel field.
   *
+  * An optional 8x8 fill pattern can be supplied as an array of 8 bytes, one for 
+  * each row, with bit 0 of each byte being the leftmost pixel. Only the LEDs with 
+  * a 1 bit in the pattern are changed and the rest are left as they are. The 
+  * pattern is aligned to the display coordinates (x%8, y%8), so adjacent 
+  * pattern fills join up seamlessly. Dither patterns for different levels of 
+  * brightness can be created with getBayerPattern(). The same pattern parameter 
+  * is available for all the filled shapes.
+  *
   * \param x1    starting x coordinate for the point [0..getXMax()].
   * \param y1    starting y coordinate for the point [0..getYMax()].
   * \param x2    ending x coordinate for the point [0..getXMax()].
   * \param y2    ending y coordinate for the point [0..getYMax()].
   * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \param pattern optional 8 byte fill pattern. If omitted, all the LEDs are filled.
   * \return false if any point is drawn outside the display, true otherwise.
   */
-  bool drawFillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state = true);
+  bool drawFillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state = true, const uint8_t *pattern = nullptr);
+
+  /**
+  * Draw a rectangle with rounded corners given two diagonal vertices
+  *
+  * Draw a rectangle given the points across the diagonal, with the corners 
+  * rounded to quarter circles of radius r. The radius is limited to half the 
+  * smaller side of the rectangle. The LEDs will be turned on or off depending 
+  * on the value supplied. The outline is drawn as spans of LEDs, setting each
+  * LED once.
+  *
+  * \param x1    starting x coordinate for the point [0..getXMax()].
+  * \param y1    starting y coordinate for the point [0..getYMax()].
+  * \param x2    ending x coordinate for the point [0..getXMax()].
+  * \param y2    ending y coordinate for the point [0..getYMax()].
+  * \param r     radius of the corners.
+  * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \return false if any point is drawn outside the display, true otherwise.
+  */
+  bool drawRoundRect(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t r, bool state = true);
+
+  /**
+  * Draw a filled rectangle with rounded corners given two diagonal vertices
+  *
+  * Draw a filled rectangle given the points across the diagonal, with the 
+  * corners rounded to quarter circles of radius r. The radius is limited to 
+  * half the smaller side of the rectangle. The LEDs inside and on the border 
+  * will be turned on or off depending on the value supplied. The rectangle
+  * is filled as spans of LEDs, setting each LED once.
+  *
+  * \param x1    starting x coordinate for the point [0..getXMax()].
+  * \param y1    starting y coordinate for the point [0..getYMax()].
+  * \param x2    ending x coordinate for the point [0..getXMax()].
+  * \param y2    ending y coordinate for the point [0..getYMax()].
+  * \param r     radius of the corners.
+  * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \param pattern optional 8 byte fill pattern, as described for drawFillRectangle(). If omitted, all the LEDs are filled.
+  * \return false if any point is drawn outside the display, true otherwise.
+  */
+  bool drawFillRoundRect(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t r, bool state = true, const uint8_t *pattern = nullptr);
 
   /**
   * Draw a triangle given 3 vertices
@@ -463,9 +643,10 @@ public:
   * \param x3    third x coordinate for the point [0..getXMax()].
   * \param y3    third y coordinate for the point [0..getYMax()].
   * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \param pattern optional 8 byte fill pattern, as described for drawFillRectangle(). If omitted, all the LEDs are filled.
   * \return false if any point is drawn outside the display, true otherwise.
   */
-  bool drawFillTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, bool state = true);
+  bool drawFillTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, bool state = true, const uint8_t *pattern = nullptr);
     
   /**
   * Draw a quadrilateral given 4 vertices
@@ -488,6 +669,86 @@ public:
   */
   bool drawQuadrilateral(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t x4, uint16_t y4, bool state = true);
 
+  /**
+  * Draw a polyline through a list of points
+  *
+  * Draw connected straight lines through the n points given in the x and y 
+  * arrays, from the first point to the last. The LEDs will be turned on or 
+  * off depending on the value supplied. All the segments are drawn before the
+  * display is updated. Segments completely outside the display are skipped.
+  *
+  * \param n     the number of points in the arrays.
+  * \param x     array of x coordinates for the points.
+  * \param y     array of y coordinates for the points.
+  * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \return false if any point is drawn outside the display, true otherwise.
+  */
+  bool drawPolyline(uint8_t n, const uint16_t *x, const uint16_t *y, bool state = true);
+
+  /**
+  * Draw a quadratic Bezier curve given 3 control points
+  *
+  * Draw a quadratic Bezier curve from (x1,y1) to (x3,y3) using (x2,y2) as the
+  * control point. The curve is calculated using fixed point forward differencing,
+  * with the number of steps depending on the size of the curve, and drawn as
+  * a polyline. Parts of the curve outside the display are clipped.
+  *
+  * The control points must be within 32767 pixels of the start point in both x
+  * and y, or the curve is not drawn. As the coordinates are unsigned, points left
+  * of or below the display cannot be used.
+  *
+  * \param x1    start x coordinate for the curve.
+  * \param y1    start y coordinate for the curve.
+  * \param x2    x coordinate for the control point.
+  * \param y2    y coordinate for the control point.
+  * \param x3    end x coordinate for the curve.
+  * \param y3    end y coordinate for the curve.
+  * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \return false if any point is drawn outside the display, true otherwise.
+  */
+  bool drawQuadBezier(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, bool state = true);
+
+  /**
+  * Draw a cubic Bezier curve given 4 control points
+  *
+  * Draw a cubic Bezier curve from (x1,y1) to (x4,y4) using (x2,y2) and (x3,y3) 
+  * as the control points. The curve is calculated using fixed point forward 
+  * differencing, with the number of steps depending on the size of the curve, 
+  * and drawn as a polyline. Parts of the curve outside the display are clipped.
+  *
+  * The control points must be within 32767 pixels of the start point in both x
+  * and y, or the curve is not drawn. As the coordinates are unsigned, points left
+  * of or below the display cannot be used.
+  *
+  * \param x1    start x coordinate for the curve.
+  * \param y1    start y coordinate for the curve.
+  * \param x2    x coordinate for the first control point.
+  * \param y2    y coordinate for the first control point.
+  * \param x3    x coordinate for the second control point.
+  * \param y3    y coordinate for the second control point.
+  * \param x4    end x coordinate for the curve.
+  * \param y4    end y coordinate for the curve.
+  * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \return false if any point is drawn outside the display, true otherwise.
+  */
+  bool drawCubicBezier(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t x4, uint16_t y4, bool state = true);
+
+  /**
+  * Draw a smooth spline curve through a list of points
+  *
+  * Draw a Catmull-Rom spline passing through the n points given in the x and y 
+  * arrays. Each section between two points is drawn as the equivalent cubic 
+  * Bezier curve. Parts of the curve outside the display are clipped. Sections
+  * with points more than 32767 pixels apart in x or y are not drawn.
+  *
+  * \param n     the number of points in the arrays.
+  * \param x     array of x coordinates for the points.
+  * \param y     array of y coordinates for the points.
+  * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \return false if any point is drawn outside the display, true otherwise.
+  */
+  bool drawSpline(uint8_t n, const uint16_t *x, const uint16_t *y, bool state = true);
+
   /**
    * Draw a circle given center and radius
    *
@@ -517,9 +778,49 @@ public:
   * \param yc    y coordinate for the center point [0..getYMax()].
   * \param r     radius of the circle.
   * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \param pattern optional 8 byte fill pattern, as described for drawFillRectangle(). If omitted, all the LEDs are filled.
   * \return false if any point is drawn outside the display, true otherwise.
   */
-  bool drawFillCircle(uint16_t xc, uint16_t yc, uint16_t r, bool state = true);
+  bool drawFillCircle(uint16_t xc, uint16_t yc, uint16_t r, bool state = true, const uint8_t *pattern = nullptr);
+
+  /**
+  * Create an ordered dither fill pattern
+  *
+  * Fill the pattern buffer with the 8x8 Bayer ordered dither pattern for the
+  * specified level. The level is the number of pixels out of 64 that are set
+  * in the pattern, so 0 is empty, 32 is a checkerboard and 64 is solid. The set
+  * pixels are evenly spread out and each level includes all the pixels of the 
+  * lower levels, so fading by stepping through the levels does not flicker.
+  *
+  * The pattern can be used with any of the filled shape methods.
+  *
+  * \param pattern pointer to a buffer of at least 8 bytes for the pattern.
+  * \param level   the number of pixels set in the pattern [0..64].
+  * \return the pattern pointer, for use as a parameter to a fill method.
+  */
+  static uint8_t *getBayerPattern(uint8_t *pattern, uint8_t level);
+
+  /**
+  * Flood fill an enclosed area of the display
+  *
+  * Fill the area connected to the seed point (x,y) and bounded by LEDs
+  * already set to the fill state. Connected LEDs are the ones directly above,
+  * below, left or right of each other. The fill works directly on the LED module
+  * data using a span based scanline algorithm, so it is fast and only uses a small,
+  * fixed amount of stack memory (FILL_STACK_SIZE seeds).
+  *
+  * If the area is so complex that the seed stack overflows, the seeds that do
+  * not fit are dropped and the parts of the area only reached through them are
+  * left unfilled, but the fill never goes outside the area. Each unfilled part can
+  * be finished by calling floodFill() again from a point inside it.
+  *
+  * \param x     x coordinate for the seed point [0..getXMax()].
+  * \param y     y coordinate for the seed point [0..getYMax()].
+  * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \return false if the seed point is outside the display or the seed stack
+  *         overflowed, true otherwise.
+  */
+  bool floodFill(uint16_t x, uint16_t y, bool state = true);
 
   /**
    * Get the status of a single LED, addressed as a pixel.
@@ -551,6 +852,28 @@ public:
    */
   bool setPoint(uint16_t x, uint16_t y, bool state = true);
 
+  /**
+   * Scroll an area of the display left by one pixel.
+   *
+   * Move the contents of the rectangular area left by one pixel and feed a 
+   * new column in at the right hand edge. The new column is a byte in the same
+   * format as a font column, with bit 0 at the top of the area (y2), so scrolling 
+   * text is fed one font column at a time. LEDs for set bits are turned to state, 
+   * the others to !state. Rows below the 8th row of the area are set to !state.
+   *
+   * The area is moved as LED module column bytes, without reading or writing 
+   * individual LEDs.
+   *
+   * \param x1    left x coordinate of the area [0..getXMax()].
+   * \param y1    bottom y coordinate of the area [0..getYMax()].
+   * \param x2    right x coordinate of the area [0..getXMax()].
+   * \param y2    top y coordinate of the area [0..getYMax()].
+   * \param col   the new column for the right hand edge. If omitted, default to 0.
+   * \param state true - switch on; false - switch off. If omitted, default to true.
+   * \return false if the area is clipped by the display edges, true otherwise.
+   */
+  bool scrollLeft(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t col = 0, bool state = true);
+
   /** @} */
 
   //--------------------------------------------------------------
@@ -564,9 +887,83 @@ public:
   * MD_MAX72xx font builder (refer to documentation for the tool and the MD_MAX72xx library).
   * Passing nullptr resets to the library default font.
   *
+  * Characters wider than FONT_WIDTH_MAX are cut to that width when drawn.
+  *
   * \param fontDef  Pointer to the font definition to be used.
+  * \return false if the font has characters wider than FONT_WIDTH_MAX, true otherwise.
+  */
+  bool setFont(MD_MAX72XX::fontType_t *fontDef) { _packedFont = nullptr; _D->setFont(fontDef); return(setFontWidth(_D->getMaxFontWidth())); }
+
+  /**
+  * Set the display font to a packed font.
+  *
+  * Set the display font to a font table in the MD_MAXPanel packed font format,
+  * which is generated from MD_MAX72xx fonts by the FontPack tool in the extras 
+  * folder of the library. Packed fonts take less flash memory than the same 
+  * MD_MAX72xx font:
+  * - character columns are stored using only as many bits as needed, either the 
+  * font height or, if smaller, an index into a dictionary of the different 
+  * columns used in the font.
+  * - an index of character widths and column offsets finds any character by 
+  * adding at most PACKED_FONT_BLOCK - 1 widths, instead of skipping over all 
+  * the characters before it.
+  * - the character codes are given by a sorted table of ranges, found by binary 
+  * search, so a font can hold a few characters from anywhere in the 16 bit 
+  * Unicode range, such as accented letters or symbols, without empty entries 
+  * for the codes in between.
+  *
+  * The packed font is used for all the text methods until setFont() is called.
+  * Passing nullptr goes back to the MD_MAX72xx font.
+  *
+  * The packed font format, all in PROGMEM, is
+  * - header: 'P', version (1), font height (1 to 8), maximum character width 
+  * (up to FONT_WIDTH_MAX), bits per column code (1 to 8), dictionary size, 
+  * number of ranges, 0.
+  * - dictionary: one byte for each column value, if the dictionary size is not 0.
+  * The dictionary has an entry for every code, so at least 2^bits entries.
+  * - ranges: first code, last code and index of the first character for each 
+  * range of character codes, as 16 bit little endian values, in code order.
+  * - index: the column offset of every PACKED_FONT_BLOCK-th character, as 
+  * 16 bit little endian values, followed by the width of each character.
+  * - data: the column codes of all the characters, packed MSB first.
+  *
+  * \sa setFont()
+  *
+  * \param font  Pointer to the packed font definition to be used.
+  * \return false if the font is not a packed font, has characters wider than 
+  * FONT_WIDTH_MAX or has a header outside the limits above, true otherwise.
+  */
+  bool setPackedFont(const uint8_t *font);
+
+  /**
+  * Get the columns of a character.
+  *
+  * Get the columns of the character from the current font, which may be an 
+  * MD_MAX72xx font or a packed font. Each column is a byte with the top row 
+  * of the character in bit 0, as for MD_MAX72XX::getChar().
+  *
+  * \param code  the character code.
+  * \param size  the size of buf in bytes. At most size columns are returned.
+  * \param buf   the buffer for the character columns.
+  * \return the width of the character in columns, 0 if it is not in the font.
   */
-  void setFont(MD_MAX72XX::fontType_t *fontDef) { _D->setFont(fontDef); }
+  uint8_t getChar(uint16_t code, uint8_t size, uint8_t *buf);
+
+  /**
+  * Get the next character from UTF-8 text.
+  *
+  * Decode the UTF-8 character at psz and move psz to the next character. All 
+  * the text methods read their text this way, so text can include characters 
+  * beyond the ASCII range as long as the font has them.
+  *
+  * Bytes that do not start a valid UTF-8 sequence are returned unchanged as 
+  * single byte characters, so text using the 8 bit codes of MD_MAX72xx fonts 
+  * still works. Characters beyond the 16 bit range are returned as 0xfffd.
+  *
+  * \param psz  reference to the pointer to the text, moved past the character.
+  * \return the character code.
+  */
+  static uint16_t getUTF8Char(const char *&psz);
   
   /**
   * Set the spacing between characters.
@@ -586,17 +983,87 @@ public:
   */
   uint8_t getCharSpacing(void) { return(_charSpacing); }
 
+  /**
+  * Set transparent text mode.
+  *
+  * In transparent mode drawText() only changes the LEDs that are part of the 
+  * characters, leaving the background as it is. Otherwise the background LEDs 
+  * of the characters and the spacing between them are set to the opposite state.
+  * The default is not transparent.
+  *
+  * \param b true for transparent text, false otherwise.
+  */
+  void setTextTransparent(bool b) { _textTransparent = b; }
+
+  /**
+  * Get transparent text mode.
+  *
+  * \return true if text is drawn transparent, false otherwise.
+  */
+  bool getTextTransparent(void) { return(_textTransparent); }
+
+  /**
+  * Glyph cache entry.
+  *
+  * A character already converted to the layout of the LED modules. The members 
+  * are only used by the library; a sketch just provides the storage for the 
+  * entries with setGlyphCache().
+  */
+  struct glyphCache_t
+  {
+    const uint8_t *font;            ///< font of the glyph, nullptr if unused
+    uint16_t code;                  ///< character code
+    uint8_t orient;                 ///< text rotation and display rotation
+    uint8_t width;                  ///< glyph width in font columns
+    uint16_t used;                  ///< use counter value when last used
+    uint8_t data[((GLYPH_CACHE_WIDTH + 7) / 8) * 8];  ///< glyph in the physical panel layout
+  };
+
+  /**
+  * Set the storage for the glyph cache.
+  *
+  * Text is drawn through a cache of characters already converted to the layout
+  * of the LED modules, so redrawing the same characters is quick. The object has 
+  * a built in cache of GLYPH_CACHE_SIZE entries, and a sketch can give it a 
+  * cache of any size instead, for example to keep the characters of a clock or
+  * a scoreboard. The entries are emptied when the cache is set.
+  *
+  * \code
+  * MD_MAXPanel::glyphCache_t cache[12];
+  * mp.setGlyphCache(cache, 12);
+  * \endcode
+  *
+  * \param cache pointer to the array of entries, nullptr to use the built in cache.
+  * \param size  the number of entries in the array [1..255].
+  */
+  void setGlyphCache(glyphCache_t *cache, uint8_t size);
+
   /**
   * Get the length of a text string in pixels.
   *
   * Get the length of a string in pixels. The text is a nul terminated characters array.
   * The returned length will include all inter-character Set number of pixel columns between each character in a displayed text.
+  * The character widths are found as for getCharWidth().
   *
   * \param psz  the text string as a nul terminated character array.
   * \return the length in pixels.
   */
   uint16_t getTextWidth(const char *psz);
 
+  /**
+  * Get the width of a character in pixels.
+  *
+  * Get the width of a character in the current font, not including the 
+  * inter-character spacing. The width of a character already in the glyph 
+  * cache is taken from there. If WIDTH_CACHE_SIZE is set, the widths are also 
+  * kept in a small cache so the font is only read the first time a character 
+  * is measured.
+  *
+  * \param c  the character code.
+  * \return the width in pixels.
+  */
+  uint8_t getCharWidth(uint16_t c);
+
   /**
   * Get the height of the current font in pixels.
   *
@@ -605,21 +1072,176 @@ public:
   *
   * \return the height in pixels.
   */
-  uint16_t getFontHeight(void) { return(_D->getFontHeight()); }
+  uint16_t getFontHeight(void) { return(_packedFont != nullptr ? _pf.height : _D->getFontHeight()); }
 
   /**
   * Draw text on the display.
   *
   * Draw the text with top left coordinates (x,y) with specified rotation.
+  * The background is also drawn unless setTextTransparent() is set.
+  *
+  * Each character column is drawn as one masked write to each LED module it
+  * touches, in all rotations. Characters are kept in a small cache, set with 
+  * setGlyphCache(), already converted to the layout of the LED modules for the 
+  * rotation, so redrawing the same characters is quick.
+  *
+  * The text can be drawn larger by an integer scale factor from 1 to 4, where 
+  * each LED of the font becomes a square block of scale x scale LEDs, including 
+  * the spacing between characters. The text is then scale times the size given 
+  * by getTextWidth() and getFontHeight(). This allows a small font to be used 
+  * for big digits instead of storing a large font for each size.
   *
   * \param x   the x coordinate for the top left corner of the first character.
   * \param y   the Y coordinate for the top left corner of the first character.
   * \param psz the text to be displayed as a nul terminated character array.
   * \param rot the required rotation orientation for the text as described in textRotation_t. Default is ROT_0.
   * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \param scale the text scale factor [1..4]. Default is 1.
   * \return the length of the text in pixels.
   */
-  uint16_t drawText(uint16_t x, uint16_t y, const char *psz, rotation_t rot = ROT_0, bool state = true);
+  uint16_t drawText(uint16_t x, uint16_t y, const char *psz, rotation_t rot = ROT_0, bool state = true, uint8_t scale = 1);
+
+  /**
+  * Draw text in a box on the display.
+  *
+  * Draw the text in the rectangular box given by the diagonal corners, starting 
+  * at the top of the box. The text is wrapped into lines at spaces, which are 
+  * dropped at the end of the line, and at newline ('\\n') characters. A word too 
+  * long for a line is broken between characters. 
+  * Each line is aligned in the box as specified and lines are separated by one 
+  * row of pixels. Text that does not fit in the box is not drawn and nothing is 
+  * drawn outside the box. Unless setTextTransparent() is set, the rest of the box 
+  * is set to the background.
+  *
+  * The characters are measured by loading them into the glyph cache (see 
+  * setGlyphCache()), so each character is only read from the font once as long 
+  * as the different characters of a line fit in the cache. Fonts wider than 
+  * GLYPH_CACHE_WIDTH are measured as for getCharWidth() and read again to draw.
+  * Text in a box is always drawn with ROT_0 rotation.
+  *
+  * \param x1    left x coordinate of the box [0..getXMax()].
+  * \param y1    bottom y coordinate of the box [0..getYMax()].
+  * \param x2    right x coordinate of the box [0..getXMax()].
+  * \param y2    top y coordinate of the box [0..getYMax()].
+  * \param psz   the text to be displayed as a nul terminated character array.
+  * \param align the alignment of each line as described in textAlign_t. Default is ALIGN_LEFT.
+  * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \return the number of bytes from the text that were displayed. The 
+  * remaining text starts at psz plus this value.
+  */
+  uint16_t drawTextBox(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, const char *psz, textAlign_t align = ALIGN_LEFT, bool state = true);
+
+  /**
+  * Redraw the changed characters of text on the display.
+  *
+  * Update text previously drawn at the same position with the same rotation,
+  * only redrawing the characters that are different from the last text. This 
+  * suits text that changes a little at a time, like a score or a clock, as going 
+  * from 12:59 to 13:00 only redraws two characters.
+  *
+  * The last text drawn is kept by the application in pszLast and is updated to 
+  * psz by this method, so pszLast must be large enough to hold psz. Set pszLast 
+  * to an empty string to draw all the text, for example after the display has 
+  * been cleared. Characters are redrawn in place while they are the same width 
+  * as the character they replace. From the first change of width the rest of 
+  * the text is redrawn and any remaining columns of the last text are cleared.
+  *
+  * \sa drawText()
+  *
+  * \param x       the x coordinate for the top left corner of the first character.
+  * \param y       the Y coordinate for the top left corner of the first character.
+  * \param psz     the text to be displayed as a nul terminated character array.
+  * \param pszLast the text last displayed at this position, updated to psz on return.
+  * \param rot     the required rotation orientation for the text as described in textRotation_t. Default is ROT_0.
+  * \param state   true - switch on; false - switch off. If omitted, default to true.
+  * \return the length of the text in pixels.
+  */
+  uint16_t drawTextChanges(uint16_t x, uint16_t y, const char *psz, char *pszLast, rotation_t rot = ROT_0, bool state = true);
+
+  /**
+  * Draw a number on the display.
+  *
+  * The digits are rendered straight from the value, most significant first, 
+  * without building a string. Digits above 9 are shown as the letters A to Z.
+  * The number is padded on the left with the pad character to make it at least
+  * width characters long. A number wider than width is shown in full.
+  *
+  * \sa drawNumberChanges(), drawTime()
+  *
+  * \param x     the x coordinate for the top left corner of the first character.
+  * \param y     the Y coordinate for the top left corner of the first character.
+  * \param value the number to display.
+  * \param width the minimum number of characters to display. Default is 0.
+  * \param pad   the character used to pad the number to width, normally ' ' or '0'. Default is ' '.
+  * \param base  the number base [2..36]. Default is 10.
+  * \param rot   the required rotation orientation for the text as described in textRotation_t. Default is ROT_0.
+  * \param state true - switch on; false - switch off. If omitted, default to true.
+  * \return the length of the number in pixels.
+  */
+  uint16_t drawNumber(uint16_t x, uint16_t y, uint32_t value, uint8_t width = 0, char pad = ' ', uint8_t base = 10, rotation_t rot = ROT_0, bool state = true);
+
+  /**
+  * Redraw the changed characters of a number on the display.
+  *
+  * Works like drawTextChanges() for a number drawn as in drawNumber(). The 
+  * characters drawn are kept in pszLast, which must be large enough to hold 
+  * them. Set pszLast to an empty string to draw the whole number.
+  *
+  * \sa drawNumber(), drawTextChanges()
+  *
+  * \param x       the x coordinate for the top left corner of the first character.
+  * \param y       the Y coordinate for the top left corner of the first character.
+  * \param value   the number to display.
+  * \param pszLast the characters last displayed at this position, updated on return.
+  * \param width   the minimum number of characters to display. Default is 0.
+  * \param pad     the character used to pad the number to width, normally ' ' or '0'. Default is ' '.
+  * \param base    the number base [2..36]. Default is 10.
+  * \param rot     the required rotation orientation for the text as described in textRotation_t. Default is ROT_0.
+  * \param state   true - switch on; false - switch off. If omitted, default to true.
+  * \return the length of the number in pixels.
+  */
+  uint16_t drawNumberChanges(uint16_t x, uint16_t y, uint32_t value, char *pszLast, uint8_t width = 0, char pad = ' ', uint8_t base = 10, rotation_t rot = ROT_0, bool state = true);
+
+  /**
+  * Draw a time in minutes and seconds on the display.
+  *
+  * The time is shown as mm:ss, with the minutes padded on the left to minDigits 
+  * characters. The seconds are always shown as two digits. Like drawNumber() 
+  * the digits are rendered straight from the value without building a string.
+  *
+  * \sa drawTimeChanges(), drawNumber()
+  *
+  * \param x         the x coordinate for the top left corner of the first character.
+  * \param y         the Y coordinate for the top left corner of the first character.
+  * \param seconds   the time to display in seconds.
+  * \param minDigits the minimum number of minutes digits, 2 for mm:ss and 3 for mmm:ss. Default is 2.
+  * \param leadZero  true to pad the minutes with '0', false to pad with spaces. Default is true.
+  * \param rot       the required rotation orientation for the text as described in textRotation_t. Default is ROT_0.
+  * \param state     true - switch on; false - switch off. If omitted, default to true.
+  * \return the length of the time in pixels.
+  */
+  uint16_t drawTime(uint16_t x, uint16_t y, uint32_t seconds, uint8_t minDigits = 2, bool leadZero = true, rotation_t rot = ROT_0, bool state = true);
+
+  /**
+  * Redraw the changed characters of a time on the display.
+  *
+  * Works like drawTextChanges() for a time drawn as in drawTime(). The 
+  * characters drawn are kept in pszLast, which must be large enough to hold 
+  * them. Set pszLast to an empty string to draw the whole time.
+  *
+  * \sa drawTime(), drawTextChanges()
+  *
+  * \param x         the x coordinate for the top left corner of the first character.
+  * \param y         the Y coordinate for the top left corner of the first character.
+  * \param seconds   the time to display in seconds.
+  * \param pszLast   the characters last displayed at this position, updated on return.
+  * \param minDigits the minimum number of minutes digits, 2 for mm:ss and 3 for mmm:ss. Default is 2.
+  * \param leadZero  true to pad the minutes with '0', false to pad with spaces. Default is true.
+  * \param rot       the required rotation orientation for the text as described in textRotation_t. Default is ROT_0.
+  * \param state     true - switch on; false - switch off. If omitted, default to true.
+  * \return the length of the time in pixels.
+  */
+  uint16_t drawTimeChanges(uint16_t x, uint16_t y, uint32_t seconds, char *pszLast, uint8_t minDigits = 2, bool leadZero = true, rotation_t rot = ROT_0, bool state = true);
 
   /** @} */
 
@@ -633,12 +1255,254 @@ private:
 
   bool _updateEnabled;  // true if display updates are suspended
   uint8_t _charSpacing; // number of pixel columns between characters
+  bool _textTransparent; // true if text background is not drawn
   bool _rotatedDisplay; // true if the display is rotated
 
   bool drawCirclePoints(uint16_t xc, uint16_t yc, uint16_t x, uint16_t y, bool state);
-  bool drawCircleLines(uint16_t xc, uint16_t yc, uint16_t x, uint16_t y, bool state);
+  bool fillCircleSpans(int16_t a, int16_t b, int16_t d, int16_t h, bool state, const uint8_t *pattern);
+  bool drawLineSegment(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state);
+  bool drawCurveSegment(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, bool state);
+  bool drawCubicSegment(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t x4, uint16_t y4, bool state);
+  uint8_t curveSteps(uint32_t length);
+  bool clipSpanLine(int32_t *a, int32_t *b, int32_t m);
+  bool fillConvexQuad(const int32_t *va, const int32_t *vb, bool state);
+  uint16_t roundRectInset(uint16_t d1, uint16_t d2, uint16_t r);
+  static uint32_t isqrt(uint32_t v);        // Integer square root
   uint16_t Y2Row(uint16_t x, uint16_t y);   // Convert y coord to linear coord
   uint16_t X2Col(uint16_t x, uint16_t y);   // Convert x coord to linear coord
+
+  // Physical panel coordinates are the unrotated display coordinates. A vertical
+  // run of physical pixels within one module maps to bits of the same column byte.
+  void toPhysical(uint16_t &x, uint16_t &y);          // Convert display coords to physical coords
+  uint16_t physColumn(uint16_t px, uint16_t py);      // Module column for a physical point
+  bool getPhysPoint(uint16_t px, uint16_t py);        // Read physical point from the module data
+  void fillPhysSpan(uint16_t px, uint16_t py1, uint16_t py2, bool state, uint8_t pmask = 0xff); // Set a vertical physical run
+  uint8_t patternMask(uint16_t px, const uint8_t *pattern);         // Column byte mask for a fill pattern
+
+  // Span coordinates (a, b) are the display coordinates swapped as needed so 
+  // that a span along b at a fixed a is a run of bits in module column bytes.
+  void toSpan(uint16_t &x, uint16_t &y);                          // Convert display coords to span coords
+  bool fillByteSpan(int16_t a, int16_t b1, int16_t b2, bool state, const uint8_t *pattern = nullptr);  // Set a clipped span along b
+  bool fillCrossSpan(int16_t b, int16_t a1, int16_t a2, bool state, const uint8_t *pattern = nullptr); // Set a clipped span along a
+  bool fillHSpan(uint16_t y, uint16_t x1, uint16_t x2, bool state, const uint8_t *pattern = nullptr);  // Set a clipped horizontal span
+  bool fillVSpan(uint16_t x, uint16_t y1, uint16_t y2, bool state, const uint8_t *pattern = nullptr);  // Set a clipped vertical span
+
+  // Flood fill seed stack. Each seed is a run of physical column x from y1 to y2 
+  // to be scanned, reached from the column x - dx.
+  struct fillSeed_t { uint16_t x, y1, y2; int8_t dx; };
+  struct fillStack_t
+  {
+    static_assert(FILL_STACK_SIZE < 256, "FILL_STACK_SIZE is too big for the seed count");
+    fillSeed_t seed[FILL_STACK_SIZE];   // the seed stack
+    uint8_t count;                      // number of seeds in the stack
+    bool dropped;                       // true if a seed did not fit
+  };
+  void fillPush(fillStack_t &s, uint16_t px, uint16_t py1, uint16_t py2, int8_t dx);
+  bool fillInside(uint16_t px, uint16_t py, bool state);
+
+  // Glyph cache. Glyphs are held in the physical panel layout for the text and 
+  // display rotation, as physical columns of bytes with the top row in the MSB.
+  static_assert(GLYPH_CACHE_SIZE >= 1, "GLYPH_CACHE_SIZE must be at least 1");
+  glyphCache_t _glyphCacheLocal[GLYPH_CACHE_SIZE];  // built in cache entries
+  glyphCache_t *_glyphCache;        // cache entries in use
+  uint8_t _glyphCacheSize;          // number of entries in _glyphCache
+  uint16_t _glyphTick;              // glyph cache use counter for LRU replacement
+
+  void glyphAxes(rotation_t rot, int8_t *e, int8_t *f);
+  glyphCache_t *getGlyph(uint16_t code, rotation_t rot, const int8_t *e, const int8_t *f, uint8_t height);
+  void glyphToPhys(const uint8_t *buf, uint8_t cols, uint8_t rows, const int8_t *e, const int8_t *f, uint8_t *data);
+  uint8_t drawGlyph(uint16_t px, uint16_t py, uint16_t code, rotation_t rot, const int8_t *e, const int8_t *f, uint8_t height, bool state, uint8_t scale = 1);
+  void drawGlyphBox(int16_t px, int16_t py, const int8_t *e, const int8_t *f, uint8_t cols, uint8_t rows, const uint8_t *data, bool state);
+  void drawScaledBox(int16_t px, int16_t py, const int8_t *e, const int8_t *f, uint8_t cols, uint8_t rows, const uint8_t *data, uint8_t scale, bool state);
+  void setPhysByte(int16_t px, int16_t row, uint8_t d, uint8_t mask, bool state);
+  uint16_t drawChars(uint16_t x, uint16_t y, const char *psz, uint16_t len, rotation_t rot, bool state, uint8_t scale);
+
+  // Source of the characters for the text methods, either UTF-8 text or the 
+  // digits of a number generated from the most significant down.
+  struct charSource_t
+  {
+    const char *psz;    // text, or nullptr for a number
+    uint32_t value;     // number
+    uint32_t div;       // place value of the next digit, 0 at the end
+    uint32_t sepDiv;    // place value of the digit after the separator, 0 if none
+    uint8_t base;       // number base
+    uint8_t pad;        // number of pad characters still to come
+    char padChar;       // pad character
+  };
+  void textSource(charSource_t &s, const char *psz);
+  void numberSource(charSource_t &s, uint32_t value, uint8_t width, char pad, uint8_t base, uint8_t digits, uint8_t sep);
+  uint16_t nextCode(charSource_t &s);
+  uint16_t drawChanges(uint16_t x, uint16_t y, charSource_t &src, char *pszLast, rotation_t rot, bool state);
+  uint16_t drawGlyphs(uint16_t &px, uint16_t &py, uint16_t code, charSource_t &s, bool lead, rotation_t rot, const int8_t *e, const int8_t *f, uint8_t height, bool state);
+
+#if WIDTH_CACHE_SIZE > 0
+  // Character width cache for the font _widthFont, indexed by the character 
+  // code modulo WIDTH_CACHE_SIZE.
+  struct widthCache_t { uint16_t code; uint8_t width; };
+  widthCache_t _widthCache[WIDTH_CACHE_SIZE];
+  const uint8_t *_widthFont;      // font for the cached widths
+#endif
+
+  // Packed font in use, or nullptr for the MD_MAX72XX font. The header 
+  // values and the table addresses are kept in _pf.
+  struct packedFont_t
+  {
+    uint8_t ranges;           // number of character code ranges
+    uint8_t height;           // font height
+    uint8_t maxWidth;         // widest character
+    uint8_t bits;             // bits in each column code
+    uint8_t dictSize;         // column dictionary entries, 0 if no dictionary
+    const uint8_t *dict;      // column dictionary
+    const uint8_t *range;     // character code ranges
+    const uint8_t *offset;    // column offset of each block of characters
+    const uint8_t *width;     // width of each character
+    const uint8_t *data;      // packed column codes
+  };
+  const uint8_t *_packedFont;
+  packedFont_t _pf;
+
+  const uint8_t *fontId(void) { return(_packedFont != nullptr ? _packedFont : _D->getFont()); }
+  uint8_t getPackedChar(uint16_t code, uint8_t size, uint8_t *buf);
+
+  // Scratch buffer for the columns of one character read from the font. The 
+  // widest character in the current font, limited to the buffer size, is set 
+  // in _fontWidth whenever the font is changed.
+  static constexpr uint8_t GLYPH_BUF_SIZE = (FONT_WIDTH_MAX > GLYPH_CACHE_WIDTH ? FONT_WIDTH_MAX : GLYPH_CACHE_WIDTH);
+  uint8_t _glyphBuf[GLYPH_BUF_SIZE];
+  uint8_t _fontWidth;
+
+  bool setFontWidth(uint8_t width) { _fontWidth = (width > GLYPH_BUF_SIZE) ? GLYPH_BUF_SIZE : width; return(width <= GLYPH_BUF_SIZE); }
+
+  // Text clipping window in physical coordinates, used when _clipText is true
+  bool _clipText;
+  int16_t _clipPx1, _clipPy1, _clipPx2, _clipPy2;
+};
+
+/**
+ * Text scroller class for MD_MAXPanel
+ *
+ * Scrolls a message from right to left through a band of the display, one 
+ * column at a time, using the current font of the MD_MAXPanel object. The band
+ * is moved using MD_MAXPanel::scrollLeft() and only the new column of the message 
+ * is fed in at each step, so the work for each step does not depend on the 
+ * length of the message. The glyph for each character is read from the font 
+ * once as it enters the band.
+ *
+ * The message text is not copied and must remain valid while it is scrolled.
+ * A pause character in the message stops the scrolling for the pause time when 
+ * it reaches the right hand edge of the band.
+ */
+class MD_MAXPanel_Scroller
+{
+public:
+  /**
+   * Class Constructor.
+   *
+   * \param mp pointer to the MD_MAXPanel object to use for display.
+   */
+  MD_MAXPanel_Scroller(MD_MAXPanel *mp);
+
+  /**
+   * Initialize the object.
+   *
+   * Set the band of the display used for scrolling and reset the scroller. The 
+   * top row of the font is displayed in the top row of the band. Normally the 
+   * band is the same height as the font.
+   *
+   * \param x1 left x coordinate of the band [0..getXMax()].
+   * \param y1 bottom y coordinate of the band [0..getYMax()].
+   * \param x2 right x coordinate of the band [0..getXMax()].
+   * \param y2 top y coordinate of the band [0..getYMax()].
+   */
+  void begin(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+
+  /**
+   * Set the message to scroll.
+   *
+   * The message is scrolled from the start, entering at the right hand edge of
+   * the band. The text is not copied and must remain in memory while it is used.
+   *
+   * \param psz the message as a nul terminated character array.
+   */
+  void setMessage(const char *psz);
+
+  /**
+   * Set the scrolling speed.
+   *
+   * \param t the time between each one column step in milliseconds.
+   */
+  void setSpeed(uint16_t t) { _speed = t; }
+
+  /**
+   * Get the scrolling speed.
+   *
+   * \return the time between each one column step in milliseconds.
+   */
+  uint16_t getSpeed(void) { return(_speed); }
+
+  /**
+   * Set the pause points.
+   *
+   * The pause character marks the pause points in the message and is not 
+   * displayed. Scrolling stops for the pause time when the pause character 
+   * reaches the right edge of the band. The default pause character is tab ('\\t').
+   *
+   * \param t the pause time in milliseconds.
+   * \param c the pause character.
+   */
+  void setPause(uint16_t t, char c = '\t') { _pauseTime = t; _pauseChar = c; }
+
+  /**
+   * Set inverted display.
+   *
+   * Normally the message is displayed as lit LEDs on a dark background. Inverted
+   * display is dark text on lit LEDs.
+   *
+   * \param b true for inverted display, false otherwise.
+   */
+  void setInvert(bool b) { _state = !b; }
+
+  /**
+   * Restart the message.
+   *
+   * Clear the band and start the message again from the right hand edge.
+   */
+  void reset(void);
+
+  /**
+   * Run the scroller.
+   *
+   * This method should be called as often as possible from loop(), as it does 
+   * not block. Each time the scrolling speed time has passed, the band is moved 
+   * one column. The message starts again once it has scrolled completely out of 
+   * the band.
+   *
+   * \return true when the message has finished scrolling out of the band, false otherwise.
+   */
+  bool tick(void);
+
+private:
+  MD_MAXPanel *_mp;         // the display
+  uint16_t _x1, _y1;        // bottom left corner of the band
+  uint16_t _x2, _y2;        // top right corner of the band
+
+  const char *_msg;         // the message
+  const char *_p;           // next character in the message
+  uint16_t _speed;          // time between steps in ms
+  uint16_t _pauseTime;      // time to pause at a pause point in ms
+  char _pauseChar;          // pause point marker character
+  bool _state;              // LED state for the text
+  bool _pausing;            // true if waiting at a pause point
+  uint32_t _timeLast;       // millis() at the last step
+
+  static const uint8_t CHAR_WIDTH_MAX = FONT_WIDTH_MAX;   // widest character scrolled; wider are truncated
+  uint8_t _glyph[CHAR_WIDTH_MAX]; // columns of the character entering the band
+  uint8_t _width;           // number of columns in _glyph
+  uint8_t _col;             // next column of _glyph to feed in
+  uint8_t _spacing;         // blank columns to feed after the character
+  uint16_t _tail;           // blank columns to feed after the message
+
+  bool step(void);          // feed the next column
 };
 
 #endif
\ No newline at end of file
@@ -14,72 +14,843 @@ This file contains font and text related methods.
  * \brief Implements font and text methods
  */
 
+// Bit expansion tables for scaled text, indexed by [scale - 2][nibble]. Each bit 
+// of the nibble becomes scale bits, keeping the bit order.
+static const uint16_t PROGMEM bitExpand[TEXT_SCALE_MAX - 1][16] =
+{
+  { 0x0000, 0x0003, 0x000c, 0x000f, 0x0030, 0x0033, 0x003c, 0x003f, 0x00c0, 0x00c3, 0x00cc, 0x00cf, 0x00f0, 0x00f3, 0x00fc, 0x00ff },
+  { 0x0000, 0x0007, 0x0038, 0x003f, 0x01c0, 0x01c7, 0x01f8, 0x01ff, 0x0e00, 0x0e07, 0x0e38, 0x0e3f, 0x0fc0, 0x0fc7, 0x0ff8, 0x0fff },
+  { 0x0000, 0x000f, 0x00f0, 0x00ff, 0x0f00, 0x0f0f, 0x0ff0, 0x0fff, 0xf000, 0xf00f, 0xf0f0, 0xf0ff, 0xff00, 0xff0f, 0xfff0, 0xffff },
+};
+
+static uint16_t pgmWord(const uint8_t *p)
+// Read a little endian 16 bit value from a byte aligned PROGMEM address
+{
+  return(pgm_read_byte(p) | (pgm_read_byte(p + 1) << 8));
+}
+
 uint16_t MD_MAXPanel::getTextWidth(const char *psz)
 {
   uint16_t  sum = 0;
-  uint8_t bufSize = _D->getMaxFontWidth();
-  uint8_t buf[bufSize];
 
   while (*psz != '\0')
   {
-    sum += _D->getChar(*psz++, bufSize, buf);
+    sum += getCharWidth(getUTF8Char(psz));
     if (*psz) sum += _charSpacing;  // next character is not nul, so add inter-character spacing
   }
 
   return(sum);
 }
 
-uint16_t MD_MAXPanel::drawText(uint16_t x, uint16_t y, const char *psz, rotation_t rot, bool state)
+uint16_t MD_MAXPanel::getUTF8Char(const char *&psz)
 {
-  uint8_t height = _D->getFontHeight();
-  uint8_t bufSize = _D->getMaxFontWidth() + _charSpacing;
-  uint8_t buf[bufSize];
-  uint8_t size;
-  uint16_t sum = 0;
+  const uint8_t *p = (const uint8_t *)psz;
+  uint8_t n;        // number of continuation bytes
+  uint16_t c;
 
-  PRINT("\ndrawText: ", psz);
-  PRINT(" height ", height);
-  while (*psz != '\0')
+  if (p[0] < 0xc2 || p[0] > 0xf4)   // ASCII, or not a valid lead byte
   {
-    PRINT("\nChar ", *psz);
-    memset(buf, '\0', bufSize*sizeof(uint8_t));
-    size = _D->getChar(*psz, bufSize, buf);
     psz++;
-    if (*psz != '\0') size += _charSpacing;   // add in the blank columns
-    sum += size;
+    return(p[0]);
+  }
 
-    // now display the char depending on what the orientation is
-    switch (rot)
+  if (p[0] < 0xe0)      { n = 1; c = p[0] & 0x1f; }
+  else if (p[0] < 0xf0) { n = 2; c = p[0] & 0x0f; }
+  else                  { n = 3; c = 0; }   // beyond 16 bits
+
+  // check the continuation bytes, which also stops at the nul
+  for (uint8_t i = 1; i <= n; i++)
+  {
+    if ((p[i] & 0xc0) != 0x80)
     {
-    case ROT_0:
-      for (uint16_t i = 0; i < size; i++)
-        for (uint16_t j = 0; j < height; j++)
-            setPoint(x + i, y - j, (buf[i] & (1 << j) ? state : !state));
-      x += size;
-      break;
+      psz++;
+      return(p[0]);
+    }
+    c = (c << 6) | (p[i] & 0x3f);
+  }
 
-    case ROT_90:
-      for (uint16_t j = 0; j < size; j++)
-        for (uint16_t i = 0; i < height; i++)
-          setPoint(x + i, y + j, (buf[j] & (1 << i) ? state : !state));
-      y += size;
-      break;
+  // reject overlong 3 byte sequences
+  if (n == 2 && c < 0x800)
+  {
+    psz++;
+    return(p[0]);
+  }
 
-    case ROT_180:
-      for (uint16_t i = 0; i < size; i++)
-        for (uint16_t j = 0; j < height; j++)
-          setPoint(x - i, y + j, (buf[i] & (1 << j) ? state : !state));
-      x -= size;
-      break;
+  psz += n + 1;
+
+  return(n == 3 ? 0xfffd : c);
+}
+
+uint8_t MD_MAXPanel::getCharWidth(uint16_t c)
+{
+  const uint8_t *font = fontId();
+
+  // the width does not depend on the rotation of a cached glyph
+  for (uint8_t i = 0; i < _glyphCacheSize; i++)
+    if (_glyphCache[i].font == font && _glyphCache[i].code == c)
+      return(_glyphCache[i].width);
+
+#if WIDTH_CACHE_SIZE > 0
+  widthCache_t *w = &_widthCache[c % WIDTH_CACHE_SIZE];
+
+  if (font != _widthFont)   // new font, so empty the cache
+  {
+    for (uint8_t i = 0; i < WIDTH_CACHE_SIZE; i++)
+    {
+      _widthCache[i].code = 0xffff;
+      _widthCache[i].width = 0;
+    }
+    _widthFont = font;
+  }
+
+  if (w->code != c)
+  {
+    w->code = c;
+    w->width = getChar(c, _fontWidth, _glyphBuf);
+  }
+
+  return(w->width);
+#else
+  return(getChar(c, _fontWidth, _glyphBuf));
+#endif
+}
+
+bool MD_MAXPanel::setPackedFont(const uint8_t *font)
+{
+  if (font == nullptr)
+  {
+    _packedFont = nullptr;
+    return(setFontWidth(_D->getMaxFontWidth()));
+  }
+
+  const uint8_t height = pgm_read_byte(font + 2);
+  const uint8_t bits = pgm_read_byte(font + 4);
+  const uint8_t dictSize = pgm_read_byte(font + 5);
+
+  // The glyphs are converted in buffers of one byte per column, and every 
+  // column code must have a dictionary entry.
+  if (pgm_read_byte(font) != PACKED_FONT_SIG || pgm_read_byte(font + 1) != PACKED_FONT_VER ||
+      pgm_read_byte(font + 3) > FONT_WIDTH_MAX ||
+      height == 0 || height > ROW_SIZE || bits == 0 || bits > 8 ||
+      (dictSize != 0 && dictSize < (1 << bits)))
+    return(false);
+
+  // keep the header values and work out where the tables are
+  _pf.height = height;
+  _pf.maxWidth = pgm_read_byte(font + 3);
+  _pf.bits = bits;
+  _pf.dictSize = dictSize;
+  _pf.ranges = pgm_read_byte(font + 6);
+  _pf.dict = font + PACKED_FONT_HDR;
+  _pf.range = _pf.dict + _pf.dictSize;
 
-    case ROT_270:
-      for (uint16_t j = 0; j < size; j++)
-        for (uint16_t i = 0; i < height; i++)
-          setPoint(x - i, y - j, (buf[j] & (1 << i) ? state : !state));
-      y -= size;
+  // the last range gives the number of characters
+  const uint8_t *r = _pf.range + (PACKED_FONT_RANGE * (_pf.ranges - 1));
+  uint16_t count = (_pf.ranges == 0) ? 0 : pgmWord(r + 4) + pgmWord(r + 2) - pgmWord(r) + 1;
+
+  _pf.offset = _pf.range + (PACKED_FONT_RANGE * _pf.ranges);
+  _pf.width = _pf.offset + (2 * ((count + PACKED_FONT_BLOCK - 1) / PACKED_FONT_BLOCK));
+  _pf.data = _pf.width + count;
+  _packedFont = font;
+
+  return(setFontWidth(_pf.maxWidth));
+}
+
+uint8_t MD_MAXPanel::getChar(uint16_t code, uint8_t size, uint8_t *buf)
+{
+  if (_packedFont != nullptr)
+    return(getPackedChar(code, size, buf));
+
+  return(_D->getChar(code, size, buf));
+}
+
+uint8_t MD_MAXPanel::getPackedChar(uint16_t code, uint8_t size, uint8_t *buf)
+// Decode the columns of the character from the packed font. The character index 
+// is found by binary search of the code ranges. The column offset is the block 
+// offset plus the widths of the characters before it in the block, and the 
+// column codes are then read as a bit stream from that offset.
+{
+  int16_t lo = 0, hi = _pf.ranges - 1;
+  uint16_t g;
+  const uint8_t *p;
+
+  for (;;)
+  {
+    if (lo > hi)
+      return(0);    // not in the font
+
+    int16_t mid = (lo + hi) / 2;
+
+    p = _pf.range + (PACKED_FONT_RANGE * mid);
+    if (code < pgmWord(p))
+      hi = mid - 1;
+    else if (code > pgmWord(p + 2))
+      lo = mid + 1;
+    else
+    {
+      g = pgmWord(p + 4) + (code - pgmWord(p));
       break;
     }
   }
 
+  p = _pf.offset + (2 * (g / PACKED_FONT_BLOCK));
+  uint16_t col = pgmWord(p);
+  uint8_t width = pgm_read_byte(_pf.width + g);
+
+  for (uint16_t i = g - (g % PACKED_FONT_BLOCK); i < g; i++)
+    col += pgm_read_byte(_pf.width + i);
+
+  if (width > size) width = size;
+
+  // stream the column codes, keeping the unread bits in acc
+  const uint32_t bit = (uint32_t)col * _pf.bits;
+  const uint8_t mask = (1 << _pf.bits) - 1;
+  uint8_t avail = ROW_SIZE - (bit % ROW_SIZE);  // unread bits in acc
+  uint16_t acc;
+
+  p = _pf.data + (bit / ROW_SIZE);
+  acc = pgm_read_byte(p++);
+
+  for (uint8_t i = 0; i < width; i++)
+  {
+    if (avail < _pf.bits)
+    {
+      acc = (acc << 8) | pgm_read_byte(p++);
+      avail += 8;
+    }
+    avail -= _pf.bits;
+
+    uint8_t v = (acc >> avail) & mask;
+
+    buf[i] = (_pf.dictSize != 0) ? pgm_read_byte(_pf.dict + v) : v;
+  }
+
+  return(width);
+}
+
+uint16_t MD_MAXPanel::drawText(uint16_t x, uint16_t y, const char *psz, rotation_t rot, bool state, uint8_t scale)
+{
+  PRINT("\ndrawText: ", psz);
+
+  scale = constrain(scale, 1, TEXT_SCALE_MAX);
+
+  return(drawChars(x, y, psz, 0xffff, rot, state, scale));
+}
+
+uint16_t MD_MAXPanel::drawTextBox(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, const char *psz, textAlign_t align, bool state)
+// Break the text into lines that fit in the box and draw each line aligned in 
+// the box with the text clipped to the box. The characters are measured by 
+// loading them into the glyph cache, so drawing the line finds them there.
+{
+  const uint8_t height = getFontHeight();
+  const bool cached = (_fontWidth <= GLYPH_CACHE_WIDTH);
+  const char *p = psz;
+  bool u = _updateEnabled;
+  int8_t e[2], f[2];
+
+  if (x1 > x2) { uint16_t t = x1; x1 = x2; x2 = t; }
+  if (y1 > y2) { uint16_t t = y1; y1 = y2; y2 = t; }
+
+  const uint16_t boxWidth = x2 - x1 + 1;
+  int16_t y = y2;     // top row of the current line
+
+  PRINT("\ndrawTextBox: ", psz);
+
+  glyphAxes(ROT_0, e, f);
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+  update(false);
+
+  if (!_textTransparent)
+    drawFillRectangle(x1, y1, x2, y2, !state);
+
+  // set the clipping window to the box
+  {
+    uint16_t px1 = x1, py1 = y1, px2 = x2, py2 = y2;
+
+    toPhysical(px1, py1);
+    toPhysical(px2, py2);
+    _clipPx1 = min(px1, px2);
+    _clipPx2 = max(px1, px2);
+    _clipPy1 = min(py1, py2);
+    _clipPy2 = max(py1, py2);
+    _clipText = true;
+  }
+
+  while (*p != '\0' && y - (height - 1) >= (int16_t)y1)
+  {
+    const char *q = p;          // scans the line
+    const char *brk = nullptr;  // start of the last run of spaces in the line
+    uint16_t w = 0, wBrk = 0;   // line width up to q and up to brk
+
+    // find the end of the line
+    while (*q != '\0' && *q != '\n')
+    {
+      const char *next = q;
+      uint16_t code = getUTF8Char(next);
+      uint16_t cw = (cached ? getGlyph(code, ROT_0, e, f, height)->width : getCharWidth(code)) + (q != p ? _charSpacing : 0);
+
+      if (*q == ' ')
+      {
+        if (q != p && q[-1] != ' ')
+        {
+          brk = q;
+          wBrk = w;
+        }
+      }
+      else if (q != p && w + cw > boxWidth)
+      {
+        if (brk != nullptr)     // wrap at the last word break
+        {
+          q = brk;
+          w = wBrk;
+        }
+        break;
+      }
+      w += cw;
+      q = next;
+    }
+
+    // draw the line
+    uint16_t x = x1;
+
+    if (w < boxWidth)
+    {
+      if (align == ALIGN_CENTER) x += (boxWidth - w) / 2;
+      else if (align == ALIGN_RIGHT) x += boxWidth - w;
+    }
+    drawChars(x, y, p, q - p, ROT_0, state, 1);
+
+    // next line starts after the spaces at a word break or the newline
+    p = q;
+    if (*p == '\n') p++;
+    else while (*p == ' ') p++;
+    y -= height + 1;
+  }
+
+  _clipText = false;
+  update(u);
+
+  return(p - psz);
+}
+
+uint16_t MD_MAXPanel::drawChars(uint16_t x, uint16_t y, const char *psz, uint16_t len, rotation_t rot, bool state, uint8_t scale)
+// Draw the text up to len bytes, scaled up scale times
+{
+  uint8_t height = getFontHeight();
+  int8_t e[2], f[2];
+  uint16_t sum = 0;
+
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+
+  // work in physical coordinates from here, stepping along the glyph columns
+  toPhysical(x, y);
+  glyphAxes(rot, e, f);
+
+  while (len > 0 && *psz != '\0')
+  {
+    const char *p = psz;
+    uint16_t code = getUTF8Char(psz);
+
+    PRINT("\nChar ", code);
+    uint16_t size = drawGlyph(x, y, code, rot, e, f, height, state, scale) * scale;
+
+    x += e[0] * size;
+    y += e[1] * size;
+
+    len = (len > psz - p) ? len - (psz - p) : 0;
+    if (len > 0 && *psz != '\0')   // clear the blank columns
+    {
+      uint8_t cols = _charSpacing * scale;
+
+      drawGlyphBox(x, y, e, f, cols, height * scale, nullptr, state);
+      x += e[0] * cols;
+      y += e[1] * cols;
+      size += cols;
+    }
+    sum += size;
+  }
+
+  update(_updateEnabled);
+
+  return(sum);
+}
+
+void MD_MAXPanel::textSource(charSource_t &s, const char *psz)
+// Set up a character source for the UTF-8 text psz
+{
+  s.psz = psz;
+}
+
+void MD_MAXPanel::numberSource(charSource_t &s, uint32_t value, uint8_t width, char pad, uint8_t base, uint8_t digits, uint8_t sep)
+// Set up a character source for the digits of value, at least digits long, 
+// padded on the left with pad to width characters. If sep is not 0 a ':' 
+// separator goes before the last sep digits.
+{
+  uint8_t n = 1;
+
+  if (base < 2 || base > 36) base = 10;
+  s.psz = nullptr;
+  s.value = value;
+  s.base = base;
+  s.padChar = pad;
+
+  // find the place value of the leading digit
+  s.div = 1;
+  while (value / s.div >= base || n < digits)
+  {
+    s.div *= base;
+    n++;
+  }
+
+  s.sepDiv = 0;
+  if (sep != 0)
+  {
+    s.sepDiv = 1;
+    while (--sep) s.sepDiv *= base;
+    n++;
+  }
+
+  s.pad = (width > n) ? width - n : 0;
+}
+
+uint16_t MD_MAXPanel::nextCode(charSource_t &s)
+// Return the next character code from the source, or 0 at the end
+{
+  if (s.psz != nullptr)
+    return(*s.psz == '\0' ? 0 : getUTF8Char(s.psz));
+
+  if (s.pad > 0)
+  {
+    s.pad--;
+    return((uint8_t)s.padChar);
+  }
+
+  if (s.div == 0)
+    return(0);
+
+  if (s.div == s.sepDiv)
+  {
+    s.sepDiv = 0;
+    return(':');
+  }
+
+  uint8_t d = (s.value / s.div) % s.base;
+
+  s.div /= s.base;
+  return(d < 10 ? '0' + d : 'A' + d - 10);
+}
+
+uint16_t MD_MAXPanel::drawTextChanges(uint16_t x, uint16_t y, const char *psz, char *pszLast, rotation_t rot, bool state)
+{
+  charSource_t s;
+
+  PRINT("\ndrawTextChanges: ", psz);
+  textSource(s, psz);
+
+  return(drawChanges(x, y, s, pszLast, rot, state));
+}
+
+uint16_t MD_MAXPanel::drawNumber(uint16_t x, uint16_t y, uint32_t value, uint8_t width, char pad, uint8_t base, rotation_t rot, bool state)
+{
+  charSource_t s;
+
+  PRINT("\ndrawNumber: ", value);
+  numberSource(s, value, width, pad, base, 1, 0);
+
+  return(drawChanges(x, y, s, nullptr, rot, state));
+}
+
+uint16_t MD_MAXPanel::drawNumberChanges(uint16_t x, uint16_t y, uint32_t value, char *pszLast, uint8_t width, char pad, uint8_t base, rotation_t rot, bool state)
+{
+  charSource_t s;
+
+  PRINT("\ndrawNumberChanges: ", value);
+  numberSource(s, value, width, pad, base, 1, 0);
+
+  return(drawChanges(x, y, s, pszLast, rot, state));
+}
+
+uint16_t MD_MAXPanel::drawTime(uint16_t x, uint16_t y, uint32_t seconds, uint8_t minDigits, bool leadZero, rotation_t rot, bool state)
+{
+  return(drawTimeChanges(x, y, seconds, nullptr, minDigits, leadZero, rot, state));
+}
+
+uint16_t MD_MAXPanel::drawTimeChanges(uint16_t x, uint16_t y, uint32_t seconds, char *pszLast, uint8_t minDigits, bool leadZero, rotation_t rot, bool state)
+// The time is drawn as the decimal number mmss with a separator before the 
+// seconds, so at least one minute digit and both seconds digits are shown.
+{
+  charSource_t s;
+
+  PRINT("\ndrawTime: ", seconds);
+  numberSource(s, ((seconds / 60) * 100) + (seconds % 60), minDigits + 3, leadZero ? '0' : ' ', 10, 3, 2);
+
+  return(drawChanges(x, y, s, pszLast, rot, state));
+}
+
+uint16_t MD_MAXPanel::drawChanges(uint16_t x, uint16_t y, charSource_t &src, char *pszLast, rotation_t rot, bool state)
+// Redraw the characters from src that differ from pszLast in place while the 
+// widths match, then redraw the tails of the text from the first change of 
+// width. With no pszLast all the characters are drawn.
+{
+  uint8_t height = getFontHeight();
+  int8_t e[2], f[2];
+  uint16_t sum = 0;
+  charSource_t p = src;
+  const char *q = (pszLast != nullptr) ? pszLast : "";
+  uint16_t cp = nextCode(p);
+  bool lead = false;
+
+  _D->control(MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+
+  // work in physical coordinates from here, stepping along the glyph columns
+  toPhysical(x, y);
+  glyphAxes(rot, e, f);
+
+  // characters that do not move
+  while (cp != 0 && *q != '\0')
+  {
+    const char *qNext = q;
+    uint16_t cq = getUTF8Char(qNext);
+    uint8_t size = getCharWidth(cp);
+
+    if (cp != cq && getCharWidth(cq) != size)
+      break;    // the rest of the text moves
+
+    if (lead)   // the spacing before this character is unchanged
+    {
+      x += e[0] * _charSpacing;
+      y += e[1] * _charSpacing;
+      sum += _charSpacing;
+    }
+    lead = true;
+
+    if (cp != cq)
+    {
+      PRINT("\nChar ", cp);
+      if (_textTransparent) drawGlyph(x, y, cq, rot, e, f, height, !state);
+      drawGlyph(x, y, cp, rot, e, f, height, state);
+    }
+
+    x += e[0] * size;
+    y += e[1] * size;
+    sum += size;
+    q = qNext;
+    cp = nextCode(p);
+  }
+
+  // the tails of the text from here have moved, so redraw them
+  if (cp != 0 || *q != '\0')
+  {
+    uint16_t lx = x, ly = y;
+    uint16_t lastSize = 0;
+    charSource_t r;
+
+    textSource(r, q);
+    if (_textTransparent)   // remove the last text first
+      lastSize = drawGlyphs(lx, ly, nextCode(r), r, lead, rot, e, f, height, !state);
+    else
+    {
+      for (uint16_t c = nextCode(r), n = 0; c != 0; c = nextCode(r), n++)
+      {
+        if (n != 0 || lead) lastSize += _charSpacing;
+        lastSize += getCharWidth(c);
+      }
+    }
+
+    uint16_t size = drawGlyphs(x, y, cp, p, lead, rot, e, f, height, state);
+
+    sum += size;
+    if (!_textTransparent)  // clear the columns left over from the last text
+    {
+      while (size < lastSize)
+      {
+        uint8_t cols = min(lastSize - size, 0xff);
+
+        drawGlyphBox(x, y, e, f, cols, height, nullptr, state);
+        x += e[0] * cols;
+        y += e[1] * cols;
+        size += cols;
+      }
+    }
+  }
+
+  if (pszLast != nullptr)   // remember the characters drawn
+  {
+    if (src.psz != nullptr)
+      strcpy(pszLast, src.psz);
+    else
+    {
+      uint16_t c;
+
+      while ((c = nextCode(src)) != 0)
+        *pszLast++ = c;
+      *pszLast = '\0';
+    }
+  }
+
+  update(_updateEnabled);
+
+  return(sum);
+}
+
+uint16_t MD_MAXPanel::drawGlyphs(uint16_t &px, uint16_t &py, uint16_t code, charSource_t &s, bool lead, rotation_t rot, const int8_t *e, const int8_t *f, uint8_t height, bool state)
+// Draw code and the rest of the characters from s from physical (px, py), 
+// leaving (px, py) after the last column drawn. If lead is set the text is 
+// preceded by the inter-character spacing.
+{
+  uint16_t sum = 0;
+
+  for ( ; code != 0; code = nextCode(s))
+  {
+    if (lead)
+    {
+      drawGlyphBox(px, py, e, f, _charSpacing, height, nullptr, state);
+      px += e[0] * _charSpacing;
+      py += e[1] * _charSpacing;
+      sum += _charSpacing;
+    }
+    lead = true;
+
+    PRINT("\nChar ", code);
+    uint8_t size = drawGlyph(px, py, code, rot, e, f, height, state);
+
+    px += e[0] * size;
+    py += e[1] * size;
+    sum += size;
+  }
+
   return(sum);
 }
+
+void MD_MAXPanel::glyphAxes(rotation_t rot, int8_t *e, int8_t *f)
+// Physical direction of the glyph columns (e) and of the rows within a glyph 
+// column (f) for the text rotation, as {x, y} steps.
+{
+  switch (rot)
+  {
+  case ROT_0:   e[0] =  1; e[1] =  0; f[0] =  0; f[1] = -1; break;
+  case ROT_90:  e[0] =  0; e[1] =  1; f[0] =  1; f[1] =  0; break;
+  case ROT_180: e[0] = -1; e[1] =  0; f[0] =  0; f[1] =  1; break;
+  case ROT_270: e[0] =  0; e[1] = -1; f[0] = -1; f[1] =  0; break;
+  }
+
+  if (_rotatedDisplay)    // display (x, y) steps are physical (y, -x) steps
+  {
+    int8_t t;
+
+    t = e[0]; e[0] = e[1]; e[1] = -t;
+    t = f[0]; f[0] = f[1]; f[1] = -t;
+  }
+}
+
+void MD_MAXPanel::setGlyphCache(glyphCache_t *cache, uint8_t size)
+{
+  if (cache == nullptr || size == 0)
+  {
+    cache = _glyphCacheLocal;
+    size = GLYPH_CACHE_SIZE;
+  }
+
+  _glyphCache = cache;
+  _glyphCacheSize = size;
+  for (uint8_t i = 0; i < size; i++)
+  {
+    _glyphCache[i].font = nullptr;
+    _glyphCache[i].used = 0;
+  }
+}
+
+MD_MAXPanel::glyphCache_t *MD_MAXPanel::getGlyph(uint16_t code, rotation_t rot, const int8_t *e, const int8_t *f, uint8_t height)
+// Return the glyph cache entry for the character in the current font and rotation.
+// If the character is not cached, it replaces the least recently used entry.
+{
+  const uint8_t *font = fontId();
+  uint8_t orient = rot | (_rotatedDisplay ? 0x80 : 0);
+  glyphCache_t *g = &_glyphCache[0];
+
+  _glyphTick++;
+  for (uint8_t i = 0; i < _glyphCacheSize; i++)
+  {
+    glyphCache_t *c = &_glyphCache[i];
+
+    if (c->font == font && c->code == code && c->orient == orient)
+    {
+      c->used = _glyphTick;
+      return(c);
+    }
+    if ((uint16_t)(_glyphTick - c->used) > (uint16_t)(_glyphTick - g->used))
+      g = c;
+  }
+
+  // Not found, so convert the font columns into the physical layout.
+  // Each physical column has enough bytes for the glyph extent along y.
+  g->font = font;
+  g->code = code;
+  g->orient = orient;
+  g->used = _glyphTick;
+  g->width = getChar(code, GLYPH_CACHE_WIDTH, _glyphBuf);
+  glyphToPhys(_glyphBuf, g->width, height, e, f, g->data);
+
+  return(g);
+}
+
+void MD_MAXPanel::glyphToPhys(const uint8_t *buf, uint8_t cols, uint8_t rows, const int8_t *e, const int8_t *f, uint8_t *data)
+// Convert cols font columns in buf into the physical layout in data. Each physical 
+// column has enough bytes for the glyph extent along y, so data needs cols bytes 
+// if the font columns are physical columns and rows * ((cols + 7) / 8) otherwise.
+{
+  const uint8_t w = (e[0] != 0) ? cols : rows;
+  const uint8_t colBytes = (((e[1] != 0) ? cols : rows) + 7) / 8;
+  const uint8_t cx = (e[0] < 0 ? cols - 1 : 0) + (f[0] < 0 ? rows - 1 : 0);
+  const uint8_t cy = (e[1] < 0 ? cols - 1 : 0) + (f[1] < 0 ? rows - 1 : 0);
+
+  memset(data, 0, w * colBytes);
+
+  for (uint8_t i = 0; i < cols; i++)
+    for (uint8_t j = 0; j < rows; j++)
+      if (buf[i] & (1 << j))
+      {
+        uint8_t px = cx + (e[0] * i) + (f[0] * j);
+        uint8_t py = cy + (e[1] * i) + (f[1] * j);
+
+        data[(px * colBytes) + (py / ROW_SIZE)] |= (0x80 >> (py % ROW_SIZE));
+      }
+}
+
+uint8_t MD_MAXPanel::drawGlyph(uint16_t px, uint16_t py, uint16_t code, rotation_t rot, const int8_t *e, const int8_t *f, uint8_t height, bool state, uint8_t scale)
+// Draw the character with its first font column at the physical point (px, py) 
+// and return its width in font columns.
+{
+  if (_fontWidth <= GLYPH_CACHE_WIDTH)
+  {
+    glyphCache_t *g = getGlyph(code, rot, e, f, height);
+
+    if (scale == 1)
+      drawGlyphBox(px, py, e, f, g->width, height, g->data, state);
+    else
+      drawScaledBox(px, py, e, f, g->width, height, g->data, scale, state);
+    return(g->width);
+  }
+
+  // Too wide for the glyph cache, so convert and draw up to 8 font columns at a time
+  uint8_t data[ROW_SIZE];
+  uint8_t width = getChar(code, _fontWidth, _glyphBuf);
+
+  for (uint8_t i = 0; i < width; i += COL_SIZE)
+  {
+    uint8_t cols = min(COL_SIZE, width - i);
+
+    glyphToPhys(_glyphBuf + i, cols, height, e, f, data);
+    if (scale == 1)
+      drawGlyphBox(px + (e[0] * i), py + (e[1] * i), e, f, cols, height, data, state);
+    else
+      drawScaledBox(px + (e[0] * i * scale), py + (e[1] * i * scale), e, f, cols, height, data, scale, state);
+  }
+
+  return(width);
+}
+
+void MD_MAXPanel::drawGlyphBox(int16_t px, int16_t py, const int8_t *e, const int8_t *f, uint8_t cols, uint8_t rows, const uint8_t *data, bool state)
+// Draw a block of glyph columns with the first row of the first column at the 
+// physical point (px, py). The data is in the glyph cache layout, or nullptr for 
+// blank columns. Lit glyph LEDs are set to state and, unless the text is transparent, 
+// the others to !state. Each physical column is written as whole module column bytes.
+{
+  if (cols == 0 || rows == 0 || (_textTransparent && data == nullptr))
+    return;
+
+  // move (px, py) to the top left corner of the block and work out the size
+  const uint8_t w = (e[0] != 0) ? cols : rows;
+  const uint8_t h = (e[1] != 0) ? cols : rows;
+  const uint8_t colBytes = (h + 7) / 8;
+
+  if (e[0] < 0) px -= cols - 1;
+  if (f[0] < 0) px -= rows - 1;
+  if (e[1] < 0) py -= cols - 1;
+  if (f[1] < 0) py -= rows - 1;
+
+  // split each byte across the two module rows it may overlap
+  const uint8_t shift = py & (ROW_SIZE - 1);
+  const int16_t row = (py - shift) / ROW_SIZE;
+
+  for (uint8_t c = 0; c < w; c++)
+  {
+    for (uint8_t n = 0; n < colBytes; n++)
+    {
+      uint8_t bits = h - (n * ROW_SIZE);
+      uint8_t mask = (bits >= ROW_SIZE) ? 0xff : (uint8_t)(0xff << (ROW_SIZE - bits));
+      uint8_t d = (data == nullptr) ? 0 : (data[(c * colBytes) + n] & mask);
+
+      if (_textTransparent) mask = d;
+
+      setPhysByte(px + c, row + n, d >> shift, mask >> shift, state);
+      if (shift != 0)
+        setPhysByte(px + c, row + n + 1, d << (ROW_SIZE - shift), mask << (ROW_SIZE - shift), state);
+    }
+  }
+}
+
+void MD_MAXPanel::drawScaledBox(int16_t px, int16_t py, const int8_t *e, const int8_t *f, uint8_t cols, uint8_t rows, const uint8_t *data, uint8_t scale, bool state)
+// Draw a block of glyph columns as for drawGlyphBox() with each LED scaled up to 
+// a block of scale x scale LEDs. Each byte of a physical column is expanded to 
+// scale bytes through the bit expansion table, and the expanded column is drawn 
+// scale times as a block in physical axes.
+{
+  static const int8_t ex[2] = { 1, 0 }, fy[2] = { 0, 1 };   // physical axes
+  const uint8_t w = (e[0] != 0) ? cols : rows;
+  const uint8_t h = (e[1] != 0) ? cols : rows;
+  const uint8_t colBytes = (h + 7) / 8;
+  const uint8_t sBytes = ((h * scale) + 7) / 8;   // bytes in a scaled column
+  uint8_t buf[(((GLYPH_CACHE_WIDTH > ROW_SIZE ? GLYPH_CACHE_WIDTH : ROW_SIZE) + 7) / 8) * TEXT_SCALE_MAX * TEXT_SCALE_MAX];
+
+  // move (px, py) to the top left corner of the scaled block
+  if (e[0] < 0) px -= (cols * scale) - 1;
+  if (f[0] < 0) px -= (rows * scale) - 1;
+  if (e[1] < 0) py -= (cols * scale) - 1;
+  if (f[1] < 0) py -= (rows * scale) - 1;
+
+  for (uint8_t c = 0; c < w; c++)
+  {
+    uint8_t *p = buf;
+
+    // expand the column bytes, most significant nibble first
+    for (uint8_t n = 0; n < colBytes; n++)
+    {
+      uint8_t d = data[(c * colBytes) + n];
+      uint32_t v = ((uint32_t)pgm_read_word(&bitExpand[scale - 2][d >> 4]) << (4 * scale)) | pgm_read_word(&bitExpand[scale - 2][d & 0xf]);
+
+      for (int8_t k = scale - 1; k >= 0; k--)
+        *p++ = v >> (k * 8);
+    }
+
+    // repeat the column across the block, dropping the expanded bytes past the glyph
+    for (uint8_t k = 1; k < scale; k++)
+      memcpy(buf + (k * sBytes), buf, sBytes);
+
+    drawGlyphBox(px + (c * scale), py, ex, fy, scale, h * scale, buf, state);
+  }
+}
+
+void MD_MAXPanel::setPhysByte(int16_t px, int16_t row, uint8_t d, uint8_t mask, bool state)
+// Set the masked bits of the module column byte for physical column px in module 
+// row row. Bits set in d are set to state, the others to !state. Off panel writes 
+// and, while drawTextBox() is clipping, bits outside the box are ignored.
+{
+  if (mask == 0 || px < 0 || px >= _xDevices * COL_SIZE || row < 0 || row >= _yDevices)
+    return;
+
+  if (_clipText)    // trim to the clipping window
+  {
+    int16_t lo = max(_clipPy1, (int16_t)(row * ROW_SIZE)) - (row * ROW_SIZE);
+    int16_t hi = min(_clipPy2, (int16_t)((row * ROW_SIZE) + ROW_SIZE - 1)) - (row * ROW_SIZE);
+
+    if (px < _clipPx1 || px > _clipPx2 || lo > hi)
+      return;
+    mask &= (uint8_t)(0xff >> lo) & (uint8_t)(0xff << (ROW_SIZE - 1 - hi));
+  }
+
+  uint16_t c = physColumn(px, row * ROW_SIZE);
+  uint8_t v = _D->getColumn(c) & ~mask;
+
+  _D->setColumn(c, v | (mask & (state ? d : ~d)));
+}
@@ -0,0 +1,104 @@
+/*
+MD_MAXPanel - Library for MAX7219/7221 LED Panel
+
+See header file for comments
+
+This file contains the text scroller class methods.
+ */
+#include <Arduino.h>
+#include "MD_MAXPanel.h"
+#include "MD_MAXPanel_lib.h"
+
+/**
+ * \file
+ * \brief Implements the text scroller class
+ */
+
+MD_MAXPanel_Scroller::MD_MAXPanel_Scroller(MD_MAXPanel *mp) :
+_mp(mp), _x1(0), _y1(0), _x2(0), _y2(0), _msg(nullptr), _p(nullptr),
+_speed(50), _pauseTime(0), _pauseChar('\t'), _state(true)
+{
+}
+
+void MD_MAXPanel_Scroller::begin(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+  _x1 = min(x1, x2);
+  _x2 = max(x1, x2);
+  _y1 = min(y1, y2);
+  _y2 = max(y1, y2);
+
+  reset();
+}
+
+void MD_MAXPanel_Scroller::setMessage(const char *psz)
+{
+  _msg = psz;
+  reset();
+}
+
+void MD_MAXPanel_Scroller::reset(void)
+{
+  _mp->drawFillRectangle(_x1, _y1, _x2, _y2, !_state);
+
+  _p = _msg;
+  _width = _col = _spacing = 0;
+  _tail = _x2 - _x1 + 1;
+  _pausing = false;
+  _timeLast = millis();
+}
+
+bool MD_MAXPanel_Scroller::tick(void)
+{
+  if (millis() - _timeLast < (_pausing ? _pauseTime : _speed))
+    return(false);
+
+  _timeLast = millis();
+  _pausing = false;
+
+  return(step());
+}
+
+bool MD_MAXPanel_Scroller::step(void)
+// Work out the next column to feed in and scroll the band. Characters are
+// read from the font as they are reached in the message. After the end of the
+// message, blank columns are fed in until it has scrolled out of the band.
+{
+  uint8_t col = 0;
+
+  if (_msg == nullptr || *_msg == '\0')
+    return(false);
+
+  while (_col >= _width && _spacing == 0)
+  {
+    if (*_p == '\0')
+    {
+      if (_tail != 0) break;    // still scrolling out the end
+
+      _p = _msg;                // start again
+      _tail = _x2 - _x1 + 1;
+      return(true);
+    }
+
+    if (*_p == _pauseChar)
+    {
+      _p++;
+      _pausing = true;
+      return(false);
+    }
+
+    _width = _mp->getChar(MD_MAXPanel::getUTF8Char(_p), CHAR_WIDTH_MAX, _glyph);
+    _col = 0;
+    _spacing = (*_p != '\0') ? _mp->getCharSpacing() : 0;
+  }
+
+  if (_col < _width)
+    col = _glyph[_col++];
+  else if (_spacing > 0)
+    _spacing--;
+  else
+    _tail--;
+
+  _mp->scrollLeft(_x1, _y1, _x2, _y2, col, _state);
+
+  return(false);
+}
@@ -45,5 +45,29 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
 
 #define X2COL(x, y) (((y / ROW_SIZE) * (getXMax() + 1)) + (getXMax() - (x % (getXMax() + 1)))) ///< Convert x coord to linear coord
 #define Y2ROW(x, y) (ROW_SIZE - (y % ROW_SIZE) - 1)    ///< Convert y coord to linear coord
+#define PHYS_BIT(py) (1 << (ROW_SIZE - 1 - ((py) % ROW_SIZE)))  ///< Module column bit mask for a physical y coord
 
 #define CHAR_SPACING_DEFAULT 1  ///< Default number of pixels between characters
+#define TEXT_SCALE_MAX 4        ///< Largest text scale factor for drawText()
+
+// Packed font format (see setPackedFont())
+#define PACKED_FONT_SIG 'P'     ///< Packed font signature byte
+#define PACKED_FONT_VER 1       ///< Packed font format version
+#define PACKED_FONT_HDR 8       ///< Bytes in the packed font header, before the dictionary
+#define PACKED_FONT_BLOCK 8     ///< Glyphs per column offset in the packed font index
+#define PACKED_FONT_RANGE 6     ///< Bytes in each packed font character range entry
+
+// Curve drawing fixed point parameters
+#define CURVE_FRAC  16          ///< Number of fractional bits in curve fixed point values
+#define CURVE_STEPS_MAX 5       ///< Maximum curve steps as power of 2. CURVE_FRAC must be >= 3 * CURVE_STEPS_MAX
+#define CURVE_SEGMENT_SHIFT 2   ///< Target polyline segment length (power of 2) used to work out the number of curve steps
+#define CURVE_SPAN_MAX 0x7fff   ///< Largest distance from the start of a curve to its other control points, so the fixed point offsets fit in 32 bits
+
+// Span fill fixed point parameters
+#define SPAN_FRAC 4             ///< Number of fractional bits in span polygon vertices
+#define SPAN_CEIL(v) (((v) + (1 << SPAN_FRAC) - 1) >> SPAN_FRAC)  ///< Round fixed point span coordinate up to a pixel
+
+#define FIXED(v, s) ((int32_t)(v) * ((int32_t)1 << (s)))   ///< Scale a value to fixed point with s fractional bits
+#define DIST(a, b) ((a) > (b) ? (a) - (b) : (b) - (a))   ///< Unsigned distance between two coordinates
+#define CURVE_ROUND(f) ((uint16_t)(((f) + (1L << (CURVE_FRAC - 1))) >> CURVE_FRAC))  ///< Round fixed point value to nearest pixel
+#define SPLINE_CTRL(p, q, r) ((uint16_t)constrain((int32_t)(p) + ((int32_t)(q) - (int32_t)(r)) / 6, 0, 0xffff))  ///< Catmull-Rom to Bezier control point